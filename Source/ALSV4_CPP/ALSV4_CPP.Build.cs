@@ -14,8 +14,14 @@ public class ALSV4_CPP : ModuleRules
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new[]
-			{"Core", "CoreUObject", "Engine", "InputCore", "NavigationSystem", "AIModule", "GameplayTasks","PhysicsCore", "Niagara"});
+			{"Core", "CoreUObject", "Engine", "InputCore", "NavigationSystem", "AIModule", "GameplayTasks","PhysicsCore", "Niagara", "ReplicationGraph"});
 
 		PrivateDependencyModuleNames.AddRange(new[] {"Slate", "SlateCore"});
+
+		// Automation tests running networked play in editor sessions, with fake connections on the server
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new[] {"UnrealEd", "OnlineSubsystemUtils", "Sockets"});
+		}
 	}
 }
\ No newline at end of file
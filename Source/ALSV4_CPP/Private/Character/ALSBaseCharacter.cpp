@@ -12,7 +12,11 @@
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
 #include "Library/ALSMathLibrary.h"
+#include "Library/ALSStats.h"
 #include "Components/ALSDebugComponent.h"
+#include "Subsystems/ALSFootstepSubsystem.h"
+#include "Subsystems/ALSLocomotionSubsystem.h"
+#include "Subsystems/ALSSignificanceSubsystem.h"
 
 #include "Components/CapsuleComponent.h"
 #include "Components/TimelineComponent.h"
@@ -23,6 +27,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
+#include "Engine/NetConnection.h"
+#include "Engine/PackageMapClient.h"
 
 
 const FName NAME_FP_Camera(TEXT("FP_Camera"));
@@ -35,6 +41,99 @@ const FName NAME_root(TEXT("root"));
 const FName NAME_spine_03(TEXT("spine_03"));
 
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Locomotion Data Sent"), STAT_ALSLocomotionDataSent, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Locomotion Data Throttled"), STAT_ALSLocomotionDataThrottled, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Locomotion Data Dropped"), STAT_ALSLocomotionDataDropped, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Locomotion Data Resent"), STAT_ALSLocomotionDataResent, STATGROUP_ALS);
+
+void FALSReplicatedLocomotion::Quantize()
+{
+	const float Scale = AccelerationQuantizationLevel == EVectorQuantization::RoundTwoDecimals
+		                    ? 100.0f
+		                    : AccelerationQuantizationLevel == EVectorQuantization::RoundOneDecimal
+		                    ? 10.0f
+		                    : 1.0f;
+	Acceleration.X = FMath::RoundToFloat(Acceleration.X * Scale) / Scale;
+	Acceleration.Y = FMath::RoundToFloat(Acceleration.Y * Scale) / Scale;
+	Acceleration.Z = FMath::RoundToFloat(Acceleration.Z * Scale) / Scale;
+
+	ControlRotation.Pitch = FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(ControlRotation.Pitch));
+	ControlRotation.Yaw = FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(ControlRotation.Yaw));
+	ControlRotation.Roll = FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(ControlRotation.Roll));
+}
+
+bool FALSReplicatedLocomotion::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	static_assert(static_cast<uint8>(EVectorQuantization::RoundTwoDecimals) < (1 << 2),
+	              "EVectorQuantization doesn't fit in 2 bits");
+	uint8 QuantizationLevel = static_cast<uint8>(AccelerationQuantizationLevel);
+	Ar.SerializeBits(&QuantizationLevel, 2);
+	if (Ar.IsLoading())
+	{
+		AccelerationQuantizationLevel = static_cast<EVectorQuantization>(QuantizationLevel);
+	}
+
+	// Serialized per connection, far viewers may only get the enums
+	uint8 bSendLocomotionData = 1;
+	if (Ar.IsSaving() && Owner.IsValid())
+	{
+		UPackageMapClient* MapClient = Cast<UPackageMapClient>(Map);
+		bSendLocomotionData = Owner->ShouldSendLocomotionData(MapClient ? MapClient->GetConnection() : nullptr);
+	}
+	Ar.SerializeBits(&bSendLocomotionData, 1);
+	bHasLocomotionData = bSendLocomotionData != 0;
+
+	bOutSuccess = true;
+	if (bHasLocomotionData)
+	{
+		switch (AccelerationQuantizationLevel)
+		{
+		case EVectorQuantization::RoundOneDecimal:
+			bOutSuccess = SerializePackedVector<10, 24>(Acceleration, Ar);
+			break;
+		case EVectorQuantization::RoundTwoDecimals:
+			bOutSuccess = SerializePackedVector<100, 30>(Acceleration, Ar);
+			break;
+		default:
+			bOutSuccess = SerializePackedVector<1, 20>(Acceleration, Ar);
+			break;
+		}
+
+		ControlRotation.SerializeCompressedShort(Ar);
+	}
+
+	// 13 bits for all enums, with room for 32 overlay states. Widen the bits below when adding enum values.
+	static_assert(static_cast<uint8>(EALSGait::Sprinting) < (1 << 2), "EALSGait doesn't fit in 2 bits");
+	static_assert(static_cast<uint8>(EALSStance::Crouching) < (1 << 1), "EALSStance doesn't fit in 1 bit");
+	static_assert(static_cast<uint8>(EALSRotationMode::Aiming) < (1 << 2), "EALSRotationMode doesn't fit in 2 bits");
+	static_assert(static_cast<uint8>(EALSOverlayState::Barrel) < (1 << 5), "EALSOverlayState doesn't fit in 5 bits");
+	static_assert(static_cast<uint8>(EALSViewMode::FirstPerson) < (1 << 1), "EALSViewMode doesn't fit in 1 bit");
+	uint8 PackedDesiredGait = static_cast<uint8>(DesiredGait);
+	uint8 PackedDesiredStance = static_cast<uint8>(DesiredStance);
+	uint8 PackedDesiredRotationMode = static_cast<uint8>(DesiredRotationMode);
+	uint8 PackedRotationMode = static_cast<uint8>(RotationMode);
+	uint8 PackedOverlayState = static_cast<uint8>(OverlayState);
+	uint8 PackedViewMode = static_cast<uint8>(ViewMode);
+	Ar.SerializeBits(&PackedDesiredGait, 2);
+	Ar.SerializeBits(&PackedDesiredStance, 1);
+	Ar.SerializeBits(&PackedDesiredRotationMode, 2);
+	Ar.SerializeBits(&PackedRotationMode, 2);
+	Ar.SerializeBits(&PackedOverlayState, 5);
+	Ar.SerializeBits(&PackedViewMode, 1);
+
+	if (Ar.IsLoading())
+	{
+		DesiredGait = static_cast<EALSGait>(PackedDesiredGait);
+		DesiredStance = static_cast<EALSStance>(PackedDesiredStance);
+		DesiredRotationMode = static_cast<EALSRotationMode>(PackedDesiredRotationMode);
+		RotationMode = static_cast<EALSRotationMode>(PackedRotationMode);
+		OverlayState = static_cast<EALSOverlayState>(PackedOverlayState);
+		ViewMode = static_cast<EALSViewMode>(PackedViewMode);
+	}
+
+	return true;
+}
+
 AALSBaseCharacter::AALSBaseCharacter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UALSCharacterMovementComponent>(CharacterMovementComponentName))
 {
@@ -80,19 +179,118 @@ void AALSBaseCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME(AALSBaseCharacter, TargetRagdollLocation);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedCurrentAcceleration, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedControlRotation, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedLocomotion, COND_SkipOwner);
 
-	DOREPLIFETIME(AALSBaseCharacter, DesiredGait);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, DesiredStance, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, DesiredRotationMode, COND_SkipOwner);
-
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, RotationMode, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, OverlayState, COND_SkipOwner);
-	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ViewMode, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, VisibleMesh, COND_SkipOwner);
 }
 
+void AALSBaseCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	ReplicatedLocomotion.Owner = this;
+	ReplicatedLocomotion.Acceleration = ReplicatedCurrentAcceleration;
+	ReplicatedLocomotion.ControlRotation = ReplicatedControlRotation;
+	ReplicatedLocomotion.AccelerationQuantizationLevel = AccelerationQuantizationLevel;
+	ReplicatedLocomotion.DesiredGait = DesiredGait;
+	ReplicatedLocomotion.DesiredStance = DesiredStance;
+	ReplicatedLocomotion.DesiredRotationMode = DesiredRotationMode;
+	ReplicatedLocomotion.RotationMode = RotationMode;
+	ReplicatedLocomotion.OverlayState = OverlayState;
+	ReplicatedLocomotion.ViewMode = ViewMode;
+	ReplicatedLocomotion.Quantize();
+
+	// Values that stopped changing are never replicated again, so connections that missed the latest ones on a
+	// reduced rate tier get them once their interval elapsed
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	bool bResend = false;
+	for (auto It = LocomotionSendStates.CreateIterator(); It; ++It)
+	{
+		const UNetConnection* Connection = It.Key().Get();
+		if (!Connection)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		FALSLocomotionSendState& SendState = It.Value();
+		if (!SendState.bPendingResend || CurrentTime < SendState.NextSendTime)
+		{
+			continue;
+		}
+
+		const FALSLocomotionReplicationTier* Tier = FindLocomotionReplicationTier(Connection);
+		if (!Tier || !Tier->bDropLocomotionData)
+		{
+			// Connections not replicated this frame catch up with the change on their next update
+			SendState.bPendingResend = false;
+			bResend = true;
+		}
+	}
+
+	if (bResend)
+	{
+		++ReplicatedLocomotion.ResendSequence;
+		INC_DWORD_STAT(STAT_ALSLocomotionDataResent);
+	}
+}
+
+const FALSLocomotionReplicationTier* AALSBaseCharacter::FindLocomotionReplicationTier(
+	const UNetConnection* Connection) const
+{
+	// Replays and connections without a view target get everything
+	const AActor* Viewer = Connection ? Connection->ViewTarget : nullptr;
+	if (!Viewer)
+	{
+		return nullptr;
+	}
+
+	// Tiers are sorted by ascending distance, so the last reached one wins
+	const float DistSquared = FVector::DistSquared(Viewer->GetActorLocation(), GetActorLocation());
+	const FALSLocomotionReplicationTier* Tier = nullptr;
+	for (const FALSLocomotionReplicationTier& Candidate : LocomotionReplicationTiers)
+	{
+		if (DistSquared >= FMath::Square(Candidate.MinDistance))
+		{
+			Tier = &Candidate;
+		}
+	}
+	return Tier;
+}
+
+bool AALSBaseCharacter::ShouldSendLocomotionData(UNetConnection* Connection)
+{
+	const FALSLocomotionReplicationTier* Tier = FindLocomotionReplicationTier(Connection);
+	if (Tier && Tier->bDropLocomotionData)
+	{
+		// Sent again once the viewer moves to another tier
+		LocomotionSendStates.FindOrAdd(Connection).bPendingResend = true;
+		INC_DWORD_STAT(STAT_ALSLocomotionDataDropped);
+		return false;
+	}
+
+	if (Tier && Tier->UpdateInterval > 0.0f)
+	{
+		const float CurrentTime = GetWorld()->GetTimeSeconds();
+		FALSLocomotionSendState& SendState = LocomotionSendStates.FindOrAdd(Connection);
+		if (CurrentTime < SendState.NextSendTime)
+		{
+			SendState.bPendingResend = true;
+			INC_DWORD_STAT(STAT_ALSLocomotionDataThrottled);
+			return false;
+		}
+		SendState.NextSendTime = CurrentTime + Tier->UpdateInterval;
+		SendState.bPendingResend = false;
+	}
+	else if (FALSLocomotionSendState* SendState = LocomotionSendStates.Find(Connection))
+	{
+		SendState->bPendingResend = false;
+	}
+
+	INC_DWORD_STAT(STAT_ALSLocomotionDataSent);
+	return true;
+}
+
 void AALSBaseCharacter::OnBreakfall_Implementation()
 {
 	Replicated_PlayMontage(GetRollAnimation(), 1.35);
@@ -109,7 +307,7 @@ void AALSBaseCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// If we're in networked game, disable curved movement
+	// If we're in networked game, disable rolling rotation
 	bEnableNetworkOptimizations = !IsNetMode(NM_Standalone);
 
 	// Make sure the mesh and animbp update after the CharacterBP to ensure it gets the most recent values.
@@ -119,14 +317,14 @@ void AALSBaseCharacter::BeginPlay()
 	SetMovementModel();
 
 	// Once, force set variables in anim bp. This ensures anim instance & character starts synchronized
-	FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-	MainAnimInstance->Gait = DesiredGait;
-	MainAnimInstance->Stance = DesiredStance;
-	MainAnimInstance->RotationMode = DesiredRotationMode;
-	AnimData.ViewMode = ViewMode;
-	MainAnimInstance->OverlayState = OverlayState;
-	AnimData.PrevMovementState = PrevMovementState;
-	MainAnimInstance->MovementState = MovementState;
+	FALSAnimCharacterState& AnimState = MainAnimInstance->GetCharacterStateMutable();
+	AnimState.Gait = DesiredGait;
+	AnimState.Stance = DesiredStance;
+	AnimState.RotationMode = DesiredRotationMode;
+	AnimState.CharacterInformation.ViewMode = ViewMode;
+	AnimState.OverlayState = OverlayState;
+	AnimState.CharacterInformation.PrevMovementState = PrevMovementState;
+	AnimState.MovementState = MovementState;
 
 	// Update states to use the initial desired values.
 	SetGait(DesiredGait);
@@ -156,9 +354,56 @@ void AALSBaseCharacter::BeginPlay()
 
 	MyCharacterMovementComponent->SetMovementSettings(GetTargetMovementSettings());
 
+	// Footstep FX are never seen or heard on dedicated servers, don't keep their assets in memory there
+	UALSFootstepSubsystem* FootstepSubsystem = GetWorld()->GetSubsystem<UALSFootstepSubsystem>();
+	if (FootstepSubsystem && !IsNetMode(NM_DedicatedServer))
+	{
+		for (UDataTable* HitDataTable : FootstepHitDataTables)
+		{
+			FootstepSubsystem->PreloadHitFX(HitDataTable);
+		}
+	}
+
+	if (bUseSignificance)
+	{
+		if (UALSSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UALSSignificanceSubsystem>())
+		{
+			SignificanceSubsystem->RegisterCharacter(this);
+		}
+	}
+
+	if (bUseBatchedLocomotion)
+	{
+		if (UALSLocomotionSubsystem* LocomotionSubsystem = GetWorld()->GetSubsystem<UALSLocomotionSubsystem>())
+		{
+			LocomotionSubsystem->RegisterCharacter(this);
+		}
+	}
+
 	DebugComponent = FindComponentByClass<UALSDebugComponent>();
 }
 
+void AALSBaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bUseSignificance)
+	{
+		if (UALSSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UALSSignificanceSubsystem>())
+		{
+			SignificanceSubsystem->UnregisterCharacter(this);
+		}
+	}
+
+	if (bEssentialValuesBatched)
+	{
+		if (UALSLocomotionSubsystem* LocomotionSubsystem = GetWorld()->GetSubsystem<UALSLocomotionSubsystem>())
+		{
+			LocomotionSubsystem->UnregisterCharacter(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AALSBaseCharacter::PreInitializeComponents()
 {
 	Super::PreInitializeComponents();
@@ -183,8 +428,11 @@ void AALSBaseCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Set required values
-	SetEssentialValues(DeltaTime);
+	// Set required values, unless the locomotion subsystem already did
+	if (!bEssentialValuesBatched)
+	{
+		SetEssentialValues(DeltaTime);
+	}
 
 	if (MovementState == EALSMovementState::Grounded)
 	{
@@ -201,8 +449,11 @@ void AALSBaseCharacter::Tick(float DeltaTime)
 	}
 
 	// Cache values
-	PreviousVelocity = GetVelocity();
-	PreviousAimYaw = AimingRotation.Yaw;
+	if (!bEssentialValuesBatched)
+	{
+		PreviousVelocity = GetVelocity();
+		PreviousAimYaw = AimingRotation.Yaw;
+	}
 }
 
 void AALSBaseCharacter::RagdollStart()
@@ -303,9 +554,9 @@ void AALSBaseCharacter::SetMovementState(const EALSMovementState NewState)
 	{
 		PrevMovementState = MovementState;
 		MovementState = NewState;
-		FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-		AnimData.PrevMovementState = PrevMovementState;
-		MainAnimInstance->MovementState = MovementState;
+		FALSAnimCharacterState& AnimState = MainAnimInstance->GetCharacterStateMutable();
+		AnimState.CharacterInformation.PrevMovementState = PrevMovementState;
+		AnimState.MovementState = MovementState;
 		OnMovementStateChanged(PrevMovementState);
 	}
 }
@@ -316,7 +567,7 @@ void AALSBaseCharacter::SetMovementAction(const EALSMovementAction NewAction)
 	{
 		const EALSMovementAction Prev = MovementAction;
 		MovementAction = NewAction;
-		MainAnimInstance->MovementAction = MovementAction;
+		MainAnimInstance->GetCharacterStateMutable().MovementAction = MovementAction;
 		OnMovementActionChanged(Prev);
 	}
 }
@@ -345,43 +596,16 @@ void AALSBaseCharacter::SetGait(const EALSGait NewGait)
 void AALSBaseCharacter::SetDesiredStance(EALSStance NewStance)
 {
 	DesiredStance = NewStance;
-	if (GetLocalRole() == ROLE_AutonomousProxy)
-	{
-		Server_SetDesiredStance(NewStance);
-	}
-}
-
-void AALSBaseCharacter::Server_SetDesiredStance_Implementation(EALSStance NewStance)
-{
-	SetDesiredStance(NewStance);
 }
 
 void AALSBaseCharacter::SetDesiredGait(const EALSGait NewGait)
 {
 	DesiredGait = NewGait;
-	if (GetLocalRole() == ROLE_AutonomousProxy)
-	{
-		Server_SetDesiredGait(NewGait);
-	}
-}
-
-void AALSBaseCharacter::Server_SetDesiredGait_Implementation(EALSGait NewGait)
-{
-	SetDesiredGait(NewGait);
 }
 
 void AALSBaseCharacter::SetDesiredRotationMode(EALSRotationMode NewRotMode)
 {
 	DesiredRotationMode = NewRotMode;
-	if (GetLocalRole() == ROLE_AutonomousProxy)
-	{
-		Server_SetDesiredRotationMode(NewRotMode);
-	}
-}
-
-void AALSBaseCharacter::Server_SetDesiredRotationMode_Implementation(EALSRotationMode NewRotMode)
-{
-	SetDesiredRotationMode(NewRotMode);
 }
 
 void AALSBaseCharacter::SetRotationMode(const EALSRotationMode NewRotationMode)
@@ -878,7 +1102,7 @@ void AALSBaseCharacter::OnMovementActionChanged(const EALSMovementAction Previou
 
 void AALSBaseCharacter::OnStanceChanged(const EALSStance PreviousStance)
 {
-	MainAnimInstance->Stance = Stance;
+	MainAnimInstance->GetCharacterStateMutable().Stance = Stance;
 
 	if (CameraBehavior)
 	{
@@ -890,7 +1114,7 @@ void AALSBaseCharacter::OnStanceChanged(const EALSStance PreviousStance)
 
 void AALSBaseCharacter::OnRotationModeChanged(EALSRotationMode PreviousRotationMode)
 {
-	MainAnimInstance->RotationMode = RotationMode;
+	MainAnimInstance->GetCharacterStateMutable().RotationMode = RotationMode;
 	if (RotationMode == EALSRotationMode::VelocityDirection && ViewMode == EALSViewMode::FirstPerson)
 	{
 		// If the new rotation mode is Velocity Direction and the character is in First Person,
@@ -908,7 +1132,7 @@ void AALSBaseCharacter::OnRotationModeChanged(EALSRotationMode PreviousRotationM
 
 void AALSBaseCharacter::OnGaitChanged(const EALSGait PreviousGait)
 {
-	MainAnimInstance->Gait = Gait;
+	MainAnimInstance->GetCharacterStateMutable().Gait = Gait;
 
 	if (CameraBehavior)
 	{
@@ -941,7 +1165,7 @@ void AALSBaseCharacter::OnViewModeChanged(const EALSViewMode PreviousViewMode)
 
 void AALSBaseCharacter::OnOverlayStateChanged(const EALSOverlayState PreviousState)
 {
-	MainAnimInstance->OverlayState = OverlayState;
+	MainAnimInstance->GetCharacterStateMutable().OverlayState = OverlayState;
 }
 
 void AALSBaseCharacter::OnVisibleMeshChanged(const USkeletalMesh* PrevVisibleMesh)
@@ -959,14 +1183,14 @@ void AALSBaseCharacter::OnVisibleMeshChanged(const USkeletalMesh* PrevVisibleMes
 	}
 
 	// Force set variables in anim bp. This ensures anim instance & character stay synchronized on mesh changes
-	FALSAnimCharacterInformation& AnimData = MainAnimInstance->GetCharacterInformationMutable();
-	MainAnimInstance->Gait = Gait;
-	MainAnimInstance->Stance = Stance;
-	MainAnimInstance->RotationMode = RotationMode;
-	AnimData.ViewMode = ViewMode;
-	MainAnimInstance->OverlayState = OverlayState;
-	AnimData.PrevMovementState = PrevMovementState;
-	MainAnimInstance->MovementState = MovementState;
+	FALSAnimCharacterState& AnimState = MainAnimInstance->GetCharacterStateMutable();
+	AnimState.Gait = Gait;
+	AnimState.Stance = Stance;
+	AnimState.RotationMode = RotationMode;
+	AnimState.CharacterInformation.ViewMode = ViewMode;
+	AnimState.OverlayState = OverlayState;
+	AnimState.CharacterInformation.PrevMovementState = PrevMovementState;
+	AnimState.MovementState = MovementState;
 }
 
 void AALSBaseCharacter::OnStartCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust)
@@ -1018,19 +1242,7 @@ void AALSBaseCharacter::OnLandFrictionReset()
 
 void AALSBaseCharacter::SetEssentialValues(float DeltaTime)
 {
-	if (GetLocalRole() != ROLE_SimulatedProxy)
-	{
-		ReplicatedCurrentAcceleration = GetCharacterMovement()->GetCurrentAcceleration();
-		ReplicatedControlRotation = GetControlRotation();
-		EasedMaxAcceleration = GetCharacterMovement()->GetMaxAcceleration();
-	}
-
-	else
-	{
-		EasedMaxAcceleration = GetCharacterMovement()->GetMaxAcceleration() != 0
-			                       ? GetCharacterMovement()->GetMaxAcceleration()
-			                       : EasedMaxAcceleration / 2;
-	}
+	UpdateReplicatedEssentialValues();
 
 	// Interp AimingRotation to current control rotation for smooth character rotation movement. Decrease InterpSpeed
 	// for slower but smoother movement.
@@ -1072,6 +1284,33 @@ void AALSBaseCharacter::SetEssentialValues(float DeltaTime)
 	SetAimYawRate(FMath::Abs((AimingRotation.Yaw - PreviousAimYaw) / DeltaTime));
 }
 
+void AALSBaseCharacter::UpdateReplicatedEssentialValues()
+{
+	if (GetLocalRole() != ROLE_SimulatedProxy)
+	{
+		ReplicatedCurrentAcceleration = GetCharacterMovement()->GetCurrentAcceleration();
+		ReplicatedControlRotation = GetControlRotation();
+		EasedMaxAcceleration = GetCharacterMovement()->GetMaxAcceleration();
+	}
+
+	else
+	{
+		EasedMaxAcceleration = GetCharacterMovement()->GetMaxAcceleration() != 0
+			                       ? GetCharacterMovement()->GetMaxAcceleration()
+			                       : EasedMaxAcceleration / 2;
+
+		if (!ReplicatedLocomotion.bHasLocomotionData)
+		{
+			// Far viewers get acceleration and control rotation at a reduced rate or not at all. Extrapolate the
+			// acceleration from the replicated movement meanwhile, and keep the last control rotation.
+			const FVector CurrentVel = GetVelocity();
+			ReplicatedCurrentAcceleration = CurrentVel.SizeSquared2D() > 1.0f
+				                                ? CurrentVel.GetSafeNormal2D() * EasedMaxAcceleration
+				                                : FVector::ZeroVector;
+		}
+	}
+}
+
 void AALSBaseCharacter::UpdateCharacterMovement()
 {
 	// Set the Allowed Gait
@@ -1241,11 +1480,21 @@ EALSGait AALSBaseCharacter::GetActualGait(EALSGait AllowedGait) const
 void AALSBaseCharacter::SmoothCharacterRotation(FRotator Target, float TargetInterpSpeed, float ActorInterpSpeed,
                                                 float DeltaTime)
 {
+	// Sub-step long frames (e.g. reduced tick rates of insignificant characters),
+	// so the rotation follows the same path as when ticking every frame
+	const float MaxStepTime = 1.0f / 30.0f;
+	const int32 NumSteps = FMath::Clamp(FMath::CeilToInt(DeltaTime / MaxStepTime), 1, 8);
+	const float StepTime = DeltaTime / NumSteps;
+
 	// Interpolate the Target Rotation for extra smooth rotation behavior
-	TargetRotation =
-		FMath::RInterpConstantTo(TargetRotation, Target, DeltaTime, TargetInterpSpeed);
-	SetActorRotation(
-		FMath::RInterpTo(GetActorRotation(), TargetRotation, DeltaTime, ActorInterpSpeed));
+	FRotator NewActorRotation = GetActorRotation();
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		TargetRotation =
+			FMath::RInterpConstantTo(TargetRotation, Target, StepTime, TargetInterpSpeed);
+		NewActorRotation = FMath::RInterpTo(NewActorRotation, TargetRotation, StepTime, ActorInterpSpeed);
+	}
+	SetActorRotation(NewActorRotation);
 }
 
 float AALSBaseCharacter::CalculateGroundedRotationRate() const
@@ -1255,8 +1504,7 @@ float AALSBaseCharacter::CalculateGroundedRotationRate() const
 	// rates for each speed. Increase the speed if the camera is rotating quickly for more responsive rotation.
 
 	const float MappedSpeedVal = MyCharacterMovementComponent->GetMappedSpeed();
-	const float CurveVal =
-		MyCharacterMovementComponent->CurrentMovementSettings.RotationRateCurve->GetFloatValue(MappedSpeedVal);
+	const float CurveVal = MyCharacterMovementComponent->GetMappedRotationRate(MappedSpeedVal);
 	const float ClampedAimYawRate = FMath::GetMappedRangeValueClamped({0.0f, 300.0f}, {1.0f, 3.0f}, AimYawRate);
 	return CurveVal * ClampedAimYawRate;
 }
@@ -1539,19 +1787,37 @@ void AALSBaseCharacter::ReplicatedRagdollEnd()
 	}
 }
 
-void AALSBaseCharacter::OnRep_RotationMode(EALSRotationMode PrevRotMode)
+void AALSBaseCharacter::OnRep_ReplicatedLocomotion()
 {
-	OnRotationModeChanged(PrevRotMode);
-}
+	if (ReplicatedLocomotion.bHasLocomotionData)
+	{
+		ReplicatedCurrentAcceleration = ReplicatedLocomotion.Acceleration;
+		ReplicatedControlRotation = ReplicatedLocomotion.ControlRotation;
+	}
+	DesiredGait = ReplicatedLocomotion.DesiredGait;
+	DesiredStance = ReplicatedLocomotion.DesiredStance;
+	DesiredRotationMode = ReplicatedLocomotion.DesiredRotationMode;
 
-void AALSBaseCharacter::OnRep_ViewMode(EALSViewMode PrevViewMode)
-{
-	OnViewModeChanged(PrevViewMode);
-}
+	if (RotationMode != ReplicatedLocomotion.RotationMode)
+	{
+		const EALSRotationMode PrevRotationMode = RotationMode;
+		RotationMode = ReplicatedLocomotion.RotationMode;
+		OnRotationModeChanged(PrevRotationMode);
+	}
 
-void AALSBaseCharacter::OnRep_OverlayState(EALSOverlayState PrevOverlayState)
-{
-	OnOverlayStateChanged(PrevOverlayState);
+	if (ViewMode != ReplicatedLocomotion.ViewMode)
+	{
+		const EALSViewMode PrevViewMode = ViewMode;
+		ViewMode = ReplicatedLocomotion.ViewMode;
+		OnViewModeChanged(PrevViewMode);
+	}
+
+	if (OverlayState != ReplicatedLocomotion.OverlayState)
+	{
+		const EALSOverlayState PrevOverlayState = OverlayState;
+		OverlayState = ReplicatedLocomotion.OverlayState;
+		OnOverlayStateChanged(PrevOverlayState);
+	}
 }
 
 void AALSBaseCharacter::OnRep_VisibleMesh(USkeletalMesh* NewVisibleMesh)
@@ -9,11 +9,21 @@
 #include "Character/ALSCharacterMovementComponent.h"
 #include "Character/ALSBaseCharacter.h"
 
+#include "Library/ALSStats.h"
+
+#include "Curves/CurveFloat.h"
 #include "Curves/CurveVector.h"
 
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Position Corrections"), STAT_ALSClientAdjustPosition, STATGROUP_ALS);
+
+/** Sample interval of the movement curves, in mapped speed (0-3) */
+const float MovementCurveSampleInterval = 1.0f / 100.0f;
+
 UALSCharacterMovementComponent::UALSCharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	SetNetworkMoveDataContainer(ALSMoveDataContainer);
 }
 
 void UALSCharacterMovementComponent::OnMovementUpdated(float DeltaTime, const FVector& OldLocation,
@@ -37,13 +47,44 @@ void UALSCharacterMovementComponent::OnMovementUpdated(float DeltaTime, const FV
 	}
 }
 
+void UALSCharacterMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+                                                    const FVector& NewAccel) // Server only
+{
+	// Apply the locomotion inputs of the client before simulating its move
+	const FALSCharacterNetworkMoveData* MoveData = static_cast<FALSCharacterNetworkMoveData*>(
+		GetCurrentNetworkMoveData());
+	AALSBaseCharacter* Character = Cast<AALSBaseCharacter>(CharacterOwner);
+	if (MoveData && Character)
+	{
+		Character->SetDesiredGait(MoveData->DesiredGait);
+		Character->SetDesiredStance(MoveData->DesiredStance);
+		Character->SetDesiredRotationMode(MoveData->DesiredRotationMode);
+		AllowedGait = MoveData->AllowedGait;
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+void UALSCharacterMovementComponent::ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc,
+                                                                         FVector NewVel, UPrimitiveComponent* NewBase,
+                                                                         FName NewBaseBoneName, bool bHasBase,
+                                                                         bool bBaseRelativePosition,
+                                                                         uint8 ServerMovementMode)
+{
+	INC_DWORD_STAT(STAT_ALSClientAdjustPosition);
+	++NumClientPositionCorrections;
+
+	Super::ClientAdjustPosition_Implementation(TimeStamp, NewLoc, NewVel, NewBase, NewBaseBoneName, bHasBase,
+	                                           bBaseRelativePosition, ServerMovementMode);
+}
+
 void UALSCharacterMovementComponent::PhysWalking(float deltaTime, int32 Iterations)
 {
-	if (CurrentMovementSettings.MovementCurve)
+	if (MovementCurveSamples.IsValid())
 	{
 		// Update the Ground Friction using the Movement Curve.
 		// This allows for fine control over movement behavior at each speed.
-		GroundFriction = CurrentMovementSettings.MovementCurve->GetVectorValue(GetMappedSpeed()).Z;
+		GroundFriction = MovementCurveSamples->EvaluateVector(GetMappedSpeed()).Z;
 	}
 	Super::PhysWalking(deltaTime, Iterations);
 }
@@ -52,22 +93,22 @@ float UALSCharacterMovementComponent::GetMaxAcceleration() const
 {
 	// Update the Acceleration using the Movement Curve.
 	// This allows for fine control over movement behavior at each speed.
-	if (!IsMovingOnGround() || !CurrentMovementSettings.MovementCurve)
+	if (!IsMovingOnGround() || !MovementCurveSamples.IsValid())
 	{
 		return Super::GetMaxAcceleration();
 	}
-	return CurrentMovementSettings.MovementCurve->GetVectorValue(GetMappedSpeed()).X;
+	return MovementCurveSamples->EvaluateVector(GetMappedSpeed()).X;
 }
 
 float UALSCharacterMovementComponent::GetMaxBrakingDeceleration() const
 {
 	// Update the Deceleration using the Movement Curve.
 	// This allows for fine control over movement behavior at each speed.
-	if (!IsMovingOnGround() || !CurrentMovementSettings.MovementCurve)
+	if (!IsMovingOnGround() || !MovementCurveSamples.IsValid())
 	{
 		return Super::GetMaxBrakingDeceleration();
 	}
-	return CurrentMovementSettings.MovementCurve->GetVectorValue(GetMappedSpeed()).Y;
+	return MovementCurveSamples->EvaluateVector(GetMappedSpeed()).Y;
 }
 
 void UALSCharacterMovementComponent::UpdateFromCompressedFlags(uint8 Flags) // Client only
@@ -99,6 +140,9 @@ void UALSCharacterMovementComponent::FSavedMove_My::Clear()
 
 	bSavedRequestMovementSettingsChange = false;
 	SavedAllowedGait = EALSGait::Walking;
+	SavedDesiredGait = EALSGait::Running;
+	SavedDesiredStance = EALSStance::Standing;
+	SavedDesiredRotationMode = EALSRotationMode::LookingDirection;
 }
 
 uint8 UALSCharacterMovementComponent::FSavedMove_My::GetCompressedFlags() const
@@ -113,6 +157,21 @@ uint8 UALSCharacterMovementComponent::FSavedMove_My::GetCompressedFlags() const
 	return Result;
 }
 
+bool UALSCharacterMovementComponent::FSavedMove_My::CanCombineWith(const FSavedMovePtr& NewMove,
+                                                                   ACharacter* InCharacter, float MaxDelta) const
+{
+	// Moves that change the locomotion inputs are kept apart so the server applies them in order
+	const FSavedMove_My* NewMyMove = static_cast<FSavedMove_My*>(NewMove.Get());
+	if (SavedAllowedGait != NewMyMove->SavedAllowedGait || SavedDesiredGait != NewMyMove->SavedDesiredGait ||
+		SavedDesiredStance != NewMyMove->SavedDesiredStance ||
+		SavedDesiredRotationMode != NewMyMove->SavedDesiredRotationMode)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
 void UALSCharacterMovementComponent::FSavedMove_My::SetMoveFor(ACharacter* Character, float InDeltaTime,
                                                                FVector const& NewAccel,
                                                                class FNetworkPredictionData_Client_Character&
@@ -126,6 +185,14 @@ void UALSCharacterMovementComponent::FSavedMove_My::SetMoveFor(ACharacter* Chara
 		bSavedRequestMovementSettingsChange = CharacterMovement->bRequestMovementSettingsChange;
 		SavedAllowedGait = CharacterMovement->AllowedGait;
 	}
+
+	AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(Character);
+	if (ALSCharacter)
+	{
+		SavedDesiredGait = ALSCharacter->GetDesiredGait();
+		SavedDesiredStance = ALSCharacter->GetDesiredStance();
+		SavedDesiredRotationMode = ALSCharacter->GetDesiredRotationMode();
+	}
 }
 
 void UALSCharacterMovementComponent::FSavedMove_My::PrepMoveFor(ACharacter* Character)
@@ -150,9 +217,50 @@ FSavedMovePtr UALSCharacterMovementComponent::FNetworkPredictionData_Client_My::
 	return MakeShared<FSavedMove_My>();
 }
 
-void UALSCharacterMovementComponent::Server_SetAllowedGait_Implementation(const EALSGait NewAllowedGait)
+FALSCharacterNetworkMoveDataContainer::FALSCharacterNetworkMoveDataContainer()
 {
-	AllowedGait = NewAllowedGait;
+	NewMoveData = &ALSDefaultMoveData[0];
+	PendingMoveData = &ALSDefaultMoveData[1];
+	OldMoveData = &ALSDefaultMoveData[2];
+}
+
+void FALSCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove,
+                                                             ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const UALSCharacterMovementComponent::FSavedMove_My& MyMove =
+		static_cast<const UALSCharacterMovementComponent::FSavedMove_My&>(ClientMove);
+	AllowedGait = MyMove.SavedAllowedGait;
+	DesiredGait = MyMove.SavedDesiredGait;
+	DesiredStance = MyMove.SavedDesiredStance;
+	DesiredRotationMode = MyMove.SavedDesiredRotationMode;
+}
+
+bool FALSCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
+                                             UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// 7 bits for all inputs
+	uint8 PackedAllowedGait = static_cast<uint8>(AllowedGait);
+	uint8 PackedDesiredGait = static_cast<uint8>(DesiredGait);
+	uint8 PackedDesiredStance = static_cast<uint8>(DesiredStance);
+	uint8 PackedDesiredRotationMode = static_cast<uint8>(DesiredRotationMode);
+	Ar.SerializeBits(&PackedAllowedGait, 2);
+	Ar.SerializeBits(&PackedDesiredGait, 2);
+	Ar.SerializeBits(&PackedDesiredStance, 1);
+	Ar.SerializeBits(&PackedDesiredRotationMode, 2);
+
+	if (Ar.IsLoading())
+	{
+		AllowedGait = static_cast<EALSGait>(FMath::Min<uint8>(PackedAllowedGait, 2));
+		DesiredGait = static_cast<EALSGait>(FMath::Min<uint8>(PackedDesiredGait, 2));
+		DesiredStance = static_cast<EALSStance>(PackedDesiredStance);
+		DesiredRotationMode = static_cast<EALSRotationMode>(FMath::Min<uint8>(PackedDesiredRotationMode, 2));
+	}
+
+	return !Ar.IsError();
 }
 
 float UALSCharacterMovementComponent::GetMappedSpeed() const
@@ -179,10 +287,19 @@ float UALSCharacterMovementComponent::GetMappedSpeed() const
 	return FMath::GetMappedRangeValueClamped({0.0f, LocWalkSpeed}, {0.0f, 1.0f}, Speed);
 }
 
+float UALSCharacterMovementComponent::GetMappedRotationRate(float MappedSpeed) const
+{
+	return RotationRateCurveSamples.IsValid() ? RotationRateCurveSamples->EvaluateFloat(MappedSpeed) : 0.0f;
+}
+
 void UALSCharacterMovementComponent::SetMovementSettings(FALSMovementSettings NewMovementSettings)
 {
 	// Set the current movement settings from the owner
 	CurrentMovementSettings = NewMovementSettings;
+	MovementCurveSamples = FALSBakedCurve::FindOrBake(CurrentMovementSettings.MovementCurve,
+	                                                  MovementCurveSampleInterval);
+	RotationRateCurveSamples = FALSBakedCurve::FindOrBake(CurrentMovementSettings.RotationRateCurve,
+	                                                      MovementCurveSampleInterval);
 	bRequestMovementSettingsChange = true;
 }
 
@@ -192,11 +309,8 @@ void UALSCharacterMovementComponent::SetAllowedGait(EALSGait NewAllowedGait)
 	{
 		if (PawnOwner->IsLocallyControlled())
 		{
+			// The server receives the allowed gait with the moves of the owning client
 			AllowedGait = NewAllowedGait;
-			if (GetCharacterOwner()->GetLocalRole() == ROLE_AutonomousProxy)
-			{
-				Server_SetAllowedGait(NewAllowedGait);
-			}
 			bRequestMovementSettingsChange = true;
 			return;
 		}
@@ -9,34 +9,66 @@
 #include "Character/ALSPlayerCameraManager.h"
 
 
+#include "Animation/Skeleton.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Character/ALSPlayerController.h"
+#include "Character/Animation/ALSCameraBehaviorAsset.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
 #include "Components/ALSDebugComponent.h"
+#include "Library/ALSStats.h"
 
 #include "Kismet/KismetMathLibrary.h"
 
 
 const FName NAME_CameraBehavior(TEXT("CameraBehavior"));
-const FName NAME_CameraOffset_X(TEXT("CameraOffset_X"));
-const FName NAME_CameraOffset_Y(TEXT("CameraOffset_Y"));
-const FName NAME_CameraOffset_Z(TEXT("CameraOffset_Z"));
-const FName NAME_Override_Debug(TEXT("Override_Debug"));
-const FName NAME_PivotLagSpeed_X(TEXT("PivotLagSpeed_X"));
-const FName NAME_PivotLagSpeed_Y(TEXT("PivotLagSpeed_Y"));
-const FName NAME_PivotLagSpeed_Z(TEXT("PivotLagSpeed_Z"));
-const FName NAME_PivotOffset_X(TEXT("PivotOffset_X"));
-const FName NAME_PivotOffset_Y(TEXT("PivotOffset_Y"));
-const FName NAME_PivotOffset_Z(TEXT("PivotOffset_Z"));
-const FName NAME_RotationLagSpeed(TEXT("RotationLagSpeed"));
-const FName NAME_Weight_FirstPerson(TEXT("Weight_FirstPerson"));
-
-
-AALSPlayerCameraManager::AALSPlayerCameraManager()
+
+/** Curve names indexed by EALSCameraCurve */
+const FName NAME_ALSCameraCurves[] =
+{
+	FName(TEXT("RotationLagSpeed")),
+	FName(TEXT("Override_Debug")),
+	FName(TEXT("PivotLagSpeed_X")),
+	FName(TEXT("PivotLagSpeed_Y")),
+	FName(TEXT("PivotLagSpeed_Z")),
+	FName(TEXT("PivotOffset_X")),
+	FName(TEXT("PivotOffset_Y")),
+	FName(TEXT("PivotOffset_Z")),
+	FName(TEXT("CameraOffset_X")),
+	FName(TEXT("CameraOffset_Y")),
+	FName(TEXT("CameraOffset_Z")),
+	FName(TEXT("Weight_FirstPerson")),
+};
+
+static_assert(UE_ARRAY_COUNT(NAME_ALSCameraCurves) == static_cast<int32>(EALSCameraCurve::MAX),
+              "Every EALSCameraCurve needs a curve name");
+
+DECLARE_CYCLE_STAT(TEXT("Camera Curves"), STAT_ALSCameraCurves, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Camera Trace"), STAT_ALSCameraTrace, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Traces Sync"), STAT_ALSCameraSyncTraces, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Traces Async"), STAT_ALSCameraAsyncTraces, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Traces Reused"), STAT_ALSCameraReusedTraces, STATGROUP_ALS);
+
+
+AALSPlayerCameraManager::AALSPlayerCameraManager(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	CameraBehavior = CreateOptionalDefaultSubobject<USkeletalMeshComponent>(NAME_CameraBehavior);
+	if (CameraBehavior)
+	{
+		CameraBehavior->SetupAttachment(GetRootComponent());
+		CameraBehavior->bHiddenInGame = true;
+	}
+}
+
+void AALSPlayerCameraManager::BeginPlay()
 {
-	CameraBehavior = CreateDefaultSubobject<USkeletalMeshComponent>(NAME_CameraBehavior);
-	CameraBehavior->SetupAttachment(GetRootComponent());
-	CameraBehavior->bHiddenInGame = true;
+	Super::BeginPlay();
+
+	if (CameraBehaviorAsset && CameraBehavior)
+	{
+		// Parameters come from the asset, the anim graph is not needed
+		CameraBehavior->SetComponentTickEnabled(false);
+	}
 }
 
 void AALSPlayerCameraManager::OnPossess(AALSBaseCharacter* NewCharacter)
@@ -46,7 +78,9 @@ void AALSPlayerCameraManager::OnPossess(AALSBaseCharacter* NewCharacter)
 	ControlledCharacter = NewCharacter;
 
 	// Update references in the Camera Behavior AnimBP.
-	UALSPlayerCameraBehavior* CastedBehv = Cast<UALSPlayerCameraBehavior>(CameraBehavior->GetAnimInstance());
+	UALSPlayerCameraBehavior* CastedBehv = CameraBehavior && !CameraBehaviorAsset
+		                                       ? Cast<UALSPlayerCameraBehavior>(CameraBehavior->GetAnimInstance())
+		                                       : nullptr;
 	if (CastedBehv)
 	{
 		NewCharacter->SetCameraBehavior(CastedBehv);
@@ -57,19 +91,34 @@ void AALSPlayerCameraManager::OnPossess(AALSBaseCharacter* NewCharacter)
 		CastedBehv->SetRotationMode(NewCharacter->GetRotationMode());
 		CastedBehv->Stance = NewCharacter->GetStance();
 		CastedBehv->ViewMode = NewCharacter->GetViewMode();
+		ResolveCameraCurveUIDs(CastedBehv);
 	}
 
 	// Initial position
 	const FVector& TPSLoc = ControlledCharacter->GetThirdPersonPivotTarget().GetLocation();
 	SetActorLocation(TPSLoc);
 	SmoothedPivotTarget.SetLocation(TPSLoc);
+	bHasCameraTraceResult = false;
+	bHasBehaviorParams = false;
 
 	DebugComponent = ControlledCharacter->FindComponentByClass<UALSDebugComponent>();
 }
 
 float AALSPlayerCameraManager::GetCameraBehaviorParam(FName CurveName) const
 {
-	UAnimInstance* Inst = CameraBehavior->GetAnimInstance();
+	if (CameraBehaviorAsset)
+	{
+		for (int32 Index = 0; Index < static_cast<int32>(EALSCameraCurve::MAX); ++Index)
+		{
+			if (NAME_ALSCameraCurves[Index] == CurveName)
+			{
+				return CameraCurveValues[Index];
+			}
+		}
+		return 0.0f;
+	}
+
+	UAnimInstance* Inst = CameraBehavior ? CameraBehavior->GetAnimInstance() : nullptr;
 	if (Inst)
 	{
 		return Inst->GetCurveValue(CurveName);
@@ -77,6 +126,120 @@ float AALSPlayerCameraManager::GetCameraBehaviorParam(FName CurveName) const
 	return 0.0f;
 }
 
+void AALSPlayerCameraManager::UpdateCameraCurveValues(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALSCameraCurves);
+
+	if (CameraBehaviorAsset)
+	{
+		EvaluateCameraBehaviorAsset(DeltaTime);
+		return;
+	}
+
+	UAnimInstance* Inst = CameraBehavior ? CameraBehavior->GetAnimInstance() : nullptr;
+	if (!Inst)
+	{
+		FMemory::Memzero(CameraCurveValues);
+		return;
+	}
+
+	ResolveCameraCurveUIDs(Inst);
+
+	// Read the evaluated curves by UID instead of looking them up by name. The camera behavior's curves aren't
+	// initialized until its first evaluation, look the curves up by name until then.
+	const FBlendedHeapCurve& AnimCurves = CameraBehavior->GetAnimationCurves();
+	if (!AnimCurves.IsValid())
+	{
+		for (int32 Index = 0; Index < static_cast<int32>(EALSCameraCurve::MAX); ++Index)
+		{
+			CameraCurveValues[Index] = Inst->GetCurveValue(NAME_ALSCameraCurves[Index]);
+		}
+		return;
+	}
+
+	for (int32 Index = 0; Index < static_cast<int32>(EALSCameraCurve::MAX); ++Index)
+	{
+		CameraCurveValues[Index] = CameraCurveUIDs[Index] != SmartName::MaxUID
+			                           ? AnimCurves.Get(CameraCurveUIDs[Index])
+			                           : 0.0f;
+	}
+}
+
+void AALSPlayerCameraManager::ResolveCameraCurveUIDs(const UAnimInstance* AnimInstance)
+{
+	const USkeleton* Skeleton = AnimInstance->CurrentSkeleton;
+	if (CameraCurveSkeleton == Skeleton && CameraCurveSkeleton.IsValid())
+	{
+		return;
+	}
+
+	CameraCurveSkeleton = Skeleton;
+	for (int32 Index = 0; Index < static_cast<int32>(EALSCameraCurve::MAX); ++Index)
+	{
+		CameraCurveUIDs[Index] = Skeleton
+			                         ? Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName,
+			                                                  NAME_ALSCameraCurves[Index])
+			                         : SmartName::MaxUID;
+	}
+}
+
+void AALSPlayerCameraManager::EvaluateCameraBehaviorAsset(float DeltaTime)
+{
+	const FALSCameraBehaviorParams TargetParams = CameraBehaviorAsset->GetParams(
+		ControlledCharacter->GetViewMode(), ControlledCharacter->GetMovementState(),
+		ControlledCharacter->GetRotationMode(), ControlledCharacter->GetStance(), ControlledCharacter->GetGait());
+	const float TargetFirstPersonWeight = ControlledCharacter->GetViewMode() == EALSViewMode::FirstPerson ? 1.0f : 0.0f;
+	float TPFOV = 90.0f;
+	float FPFOV = 90.0f;
+	bool bRightShoulder = false;
+	ControlledCharacter->GetCameraParameters(TPFOV, FPFOV, bRightShoulder);
+
+	// Blend towards the parameters of the current state, like the state machine of the anim graph
+	if (bHasBehaviorParams)
+	{
+		const float BlendSpeed = CameraBehaviorAsset->BlendSpeed;
+		CurrentBehaviorParams.RotationLagSpeed = FMath::FInterpTo(CurrentBehaviorParams.RotationLagSpeed,
+		                                                          TargetParams.RotationLagSpeed, DeltaTime, BlendSpeed);
+		CurrentBehaviorParams.PivotLagSpeed = FMath::VInterpTo(CurrentBehaviorParams.PivotLagSpeed,
+		                                                       TargetParams.PivotLagSpeed, DeltaTime, BlendSpeed);
+		CurrentBehaviorParams.PivotOffset = FMath::VInterpTo(CurrentBehaviorParams.PivotOffset,
+		                                                     TargetParams.PivotOffset, DeltaTime, BlendSpeed);
+		CurrentBehaviorParams.CameraOffset = FMath::VInterpTo(CurrentBehaviorParams.CameraOffset,
+		                                                      FVector(TargetParams.CameraOffset.X,
+		                                                              bRightShoulder
+			                                                              ? TargetParams.CameraOffset.Y
+			                                                              : -TargetParams.CameraOffset.Y,
+		                                                              TargetParams.CameraOffset.Z),
+		                                                      DeltaTime, BlendSpeed);
+		CurrentFirstPersonWeight = FMath::FInterpTo(CurrentFirstPersonWeight, TargetFirstPersonWeight, DeltaTime,
+		                                            CameraBehaviorAsset->ViewModeBlendSpeed);
+	}
+	else
+	{
+		CurrentBehaviorParams = TargetParams;
+		CurrentBehaviorParams.CameraOffset.Y *= bRightShoulder ? 1.0f : -1.0f;
+		CurrentFirstPersonWeight = TargetFirstPersonWeight;
+		bHasBehaviorParams = true;
+	}
+
+	auto SetValue = [this](EALSCameraCurve Curve, float Value)
+	{
+		CameraCurveValues[static_cast<int32>(Curve)] = Value;
+	};
+	SetValue(EALSCameraCurve::RotationLagSpeed, CurrentBehaviorParams.RotationLagSpeed);
+	SetValue(EALSCameraCurve::Override_Debug, 0.0f);
+	SetValue(EALSCameraCurve::PivotLagSpeed_X, CurrentBehaviorParams.PivotLagSpeed.X);
+	SetValue(EALSCameraCurve::PivotLagSpeed_Y, CurrentBehaviorParams.PivotLagSpeed.Y);
+	SetValue(EALSCameraCurve::PivotLagSpeed_Z, CurrentBehaviorParams.PivotLagSpeed.Z);
+	SetValue(EALSCameraCurve::PivotOffset_X, CurrentBehaviorParams.PivotOffset.X);
+	SetValue(EALSCameraCurve::PivotOffset_Y, CurrentBehaviorParams.PivotOffset.Y);
+	SetValue(EALSCameraCurve::PivotOffset_Z, CurrentBehaviorParams.PivotOffset.Z);
+	SetValue(EALSCameraCurve::CameraOffset_X, CurrentBehaviorParams.CameraOffset.X);
+	SetValue(EALSCameraCurve::CameraOffset_Y, CurrentBehaviorParams.CameraOffset.Y);
+	SetValue(EALSCameraCurve::CameraOffset_Z, CurrentBehaviorParams.CameraOffset.Z);
+	SetValue(EALSCameraCurve::Weight_FirstPerson, CurrentFirstPersonWeight);
+}
+
 void AALSPlayerCameraManager::UpdateViewTargetInternal(FTViewTarget& OutVT, float DeltaTime)
 {
 	// Partially taken from base class
@@ -139,19 +302,21 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	bool bRightShoulder = false;
 	ControlledCharacter->GetCameraParameters(TPFOV, FPFOV, bRightShoulder);
 
+	UpdateCameraCurveValues(DeltaTime);
+	const float DebugOverride = GetCachedCameraParam(EALSCameraCurve::Override_Debug);
+
 	// Step 2: Calculate Target Camera Rotation. Use the Control Rotation and interpolate for smooth camera rotation.
 	const FRotator& InterpResult = FMath::RInterpTo(GetCameraRotation(),
 	                                                GetOwningPlayerController()->GetControlRotation(), DeltaTime,
-	                                                GetCameraBehaviorParam(NAME_RotationLagSpeed));
+	                                                GetCachedCameraParam(EALSCameraCurve::RotationLagSpeed));
 
-	TargetCameraRotation = UKismetMathLibrary::RLerp(InterpResult, DebugViewRotation,
-	                                                 GetCameraBehaviorParam(TEXT("Override_Debug")), true);
+	TargetCameraRotation = UKismetMathLibrary::RLerp(InterpResult, DebugViewRotation, DebugOverride, true);
 
 	// Step 3: Calculate the Smoothed Pivot Target (Orange Sphere).
 	// Get the 3P Pivot Target (Green Sphere) and interpolate using axis independent lag for maximum control.
-	const FVector LagSpd(GetCameraBehaviorParam(NAME_PivotLagSpeed_X),
-	                     GetCameraBehaviorParam(NAME_PivotLagSpeed_Y),
-	                     GetCameraBehaviorParam(NAME_PivotLagSpeed_Z));
+	const FVector LagSpd(GetCachedCameraParam(EALSCameraCurve::PivotLagSpeed_X),
+	                     GetCachedCameraParam(EALSCameraCurve::PivotLagSpeed_Y),
+	                     GetCachedCameraParam(EALSCameraCurve::PivotLagSpeed_Z));
 
 	const FVector& AxisIndpLag = CalculateAxisIndependentLag(SmoothedPivotTarget.GetLocation(),
 	                                                         PivotTarget.GetLocation(), TargetCameraRotation, LagSpd,
@@ -163,25 +328,22 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 
 	// Step 4: Calculate Pivot Location (BlueSphere). Get the Smoothed
 	// Pivot Target and apply local offsets for further camera control.
+	const FRotationMatrix PivotRotation(SmoothedPivotTarget.Rotator());
 	PivotLocation =
 		SmoothedPivotTarget.GetLocation() +
-		UKismetMathLibrary::GetForwardVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			NAME_PivotOffset_X) +
-		UKismetMathLibrary::GetRightVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			NAME_PivotOffset_Y) +
-		UKismetMathLibrary::GetUpVector(SmoothedPivotTarget.Rotator()) * GetCameraBehaviorParam(
-			NAME_PivotOffset_Z);
+		PivotRotation.GetScaledAxis(EAxis::X) * GetCachedCameraParam(EALSCameraCurve::PivotOffset_X) +
+		PivotRotation.GetScaledAxis(EAxis::Y) * GetCachedCameraParam(EALSCameraCurve::PivotOffset_Y) +
+		PivotRotation.GetScaledAxis(EAxis::Z) * GetCachedCameraParam(EALSCameraCurve::PivotOffset_Z);
 
 	// Step 5: Calculate Target Camera Location. Get the Pivot location and apply camera relative offsets.
-	TargetCameraLocation = UKismetMathLibrary::VLerp(
+	const FRotationMatrix CameraRotation(TargetCameraRotation);
+	TargetCameraLocation = FMath::Lerp(
 		PivotLocation +
-		UKismetMathLibrary::GetForwardVector(TargetCameraRotation) * GetCameraBehaviorParam(
-			NAME_CameraOffset_X) +
-		UKismetMathLibrary::GetRightVector(TargetCameraRotation) * GetCameraBehaviorParam(NAME_CameraOffset_Y)
-		+
-		UKismetMathLibrary::GetUpVector(TargetCameraRotation) * GetCameraBehaviorParam(NAME_CameraOffset_Z),
+		CameraRotation.GetScaledAxis(EAxis::X) * GetCachedCameraParam(EALSCameraCurve::CameraOffset_X) +
+		CameraRotation.GetScaledAxis(EAxis::Y) * GetCachedCameraParam(EALSCameraCurve::CameraOffset_Y) +
+		CameraRotation.GetScaledAxis(EAxis::Z) * GetCachedCameraParam(EALSCameraCurve::CameraOffset_Z),
 		PivotTarget.GetLocation() + DebugViewOffset,
-		GetCameraBehaviorParam(NAME_Override_Debug));
+		DebugOverride);
 
 	// Step 6: Trace for an object between the camera and character to apply a corrective offset.
 	// Trace origins are set within the Character BP via the Camera Interface.
@@ -190,17 +352,81 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 	float TraceRadius;
 	ECollisionChannel TraceChannel = ControlledCharacter->GetThirdPersonTraceParams(TraceOrigin, TraceRadius);
 
+	TargetCameraLocation += TraceCameraCollision(TraceOrigin, TraceRadius, TraceChannel);
+
+	// Step 8: Lerp First Person Override and return target camera parameters.
+	FTransform TargetCameraTransform(TargetCameraRotation, TargetCameraLocation, FVector::OneVector);
+	FTransform FPTargetCameraTransform(TargetCameraRotation, FPTarget, FVector::OneVector);
+
+	const float FirstPersonWeight = GetCachedCameraParam(EALSCameraCurve::Weight_FirstPerson);
+	const FTransform& MixedTransform = UKismetMathLibrary::TLerp(TargetCameraTransform, FPTargetCameraTransform,
+	                                                             FirstPersonWeight);
+
+	const FTransform& TargetTransform = UKismetMathLibrary::TLerp(MixedTransform,
+	                                                              FTransform(DebugViewRotation, TargetCameraLocation,
+	                                                                         FVector::OneVector),
+	                                                              DebugOverride);
+
+	Location = TargetTransform.GetLocation();
+	Rotation = TargetTransform.Rotator();
+	FOV = FMath::Lerp(TPFOV, FPFOV, FirstPersonWeight);
+
+	return true;
+}
+
+FVector AALSPlayerCameraManager::TraceCameraCollision(const FVector& TraceOrigin, float TraceRadius,
+                                                      ECollisionChannel TraceChannel)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALSCameraTrace);
+
 	UWorld* World = GetWorld();
 	check(World);
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
+	// Neither the origin nor the camera moved noticeably since a recent trace, the last result is still good
+	if (bHasCameraTraceResult && CameraTraceReuseDistance > 0.0f && TraceRadius == LastCameraTraceRadius &&
+		World->GetTimeSeconds() - LastCameraTraceTime <= CameraTraceReuseMaxAge &&
+		FVector::DistSquared(TraceOrigin, LastCameraTraceOrigin) <= FMath::Square(CameraTraceReuseDistance) &&
+		FVector::DistSquared(TargetCameraLocation, LastCameraTraceEnd) <= FMath::Square(CameraTraceReuseDistance))
+	{
+		INC_DWORD_STAT(STAT_ALSCameraReusedTraces);
+		return LastCameraTraceOffset;
+	}
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSCameraTrace), false, this);
 	Params.AddIgnoredActor(ControlledCharacter);
 
-	FHitResult HitResult;
 	const FCollisionShape SphereCollisionShape = FCollisionShape::MakeSphere(TraceRadius);
-	const bool bHit = World->SweepSingleByChannel(HitResult, TraceOrigin, TargetCameraLocation, FQuat::Identity,
-	                                              TraceChannel, SphereCollisionShape, Params);
+	FHitResult HitResult;
+	bool bHit = false;
+	bool bHasResult = false;
+
+	if (bUseAsyncCameraTrace)
+	{
+		FTraceDatum TraceDatum;
+		const bool bHasLastResult = CameraTraceHandle.IsValid() && World->QueryTraceData(CameraTraceHandle, TraceDatum);
+
+		INC_DWORD_STAT(STAT_ALSCameraAsyncTraces);
+		CameraTraceHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, TraceOrigin, TargetCameraLocation,
+		                                               FQuat::Identity, TraceChannel, SphereCollisionShape, Params);
+
+		if (bHasLastResult)
+		{
+			// Apply last frame's hit time to the current trace, like a spring arm with a frame of lag
+			HitResult = TraceDatum.OutHits.Num() > 0 ? TraceDatum.OutHits[0] : FHitResult(1.0f);
+			HitResult.TraceStart = TraceOrigin;
+			HitResult.TraceEnd = TargetCameraLocation;
+			HitResult.Location = FMath::Lerp(TraceOrigin, TargetCameraLocation, HitResult.Time);
+			bHit = HitResult.bBlockingHit;
+			bHasResult = true;
+		}
+	}
+
+	if (!bHasResult)
+	{
+		INC_DWORD_STAT(STAT_ALSCameraSyncTraces);
+		bHit = World->SweepSingleByChannel(HitResult, TraceOrigin, TargetCameraLocation, FQuat::Identity,
+		                                   TraceChannel, SphereCollisionShape, Params);
+	}
 
 	if (DebugComponent && DebugComponent->GetShowTraces())
 	{
@@ -216,28 +442,11 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 		                                               5.0f);
 	}
 
-	if (HitResult.IsValidBlockingHit())
-	{
-		TargetCameraLocation += HitResult.Location - HitResult.TraceEnd;
-	}
-
-	// Step 8: Lerp First Person Override and return target camera parameters.
-	FTransform TargetCameraTransform(TargetCameraRotation, TargetCameraLocation, FVector::OneVector);
-	FTransform FPTargetCameraTransform(TargetCameraRotation, FPTarget, FVector::OneVector);
-
-	const FTransform& MixedTransform = UKismetMathLibrary::TLerp(TargetCameraTransform, FPTargetCameraTransform,
-	                                                             GetCameraBehaviorParam(
-		                                                             NAME_Weight_FirstPerson));
-
-	const FTransform& TargetTransform = UKismetMathLibrary::TLerp(MixedTransform,
-	                                                              FTransform(DebugViewRotation, TargetCameraLocation,
-	                                                                         FVector::OneVector),
-	                                                              GetCameraBehaviorParam(
-		                                                              NAME_Override_Debug));
-
-	Location = TargetTransform.GetLocation();
-	Rotation = TargetTransform.Rotator();
-	FOV = FMath::Lerp(TPFOV, FPFOV, GetCameraBehaviorParam(NAME_Weight_FirstPerson));
-
-	return true;
+	bHasCameraTraceResult = true;
+	LastCameraTraceOrigin = TraceOrigin;
+	LastCameraTraceEnd = TargetCameraLocation;
+	LastCameraTraceRadius = TraceRadius;
+	LastCameraTraceTime = World->GetTimeSeconds();
+	LastCameraTraceOffset = HitResult.IsValidBlockingHit() ? HitResult.Location - HitResult.TraceEnd : FVector::ZeroVector;
+	return LastCameraTraceOffset;
 }
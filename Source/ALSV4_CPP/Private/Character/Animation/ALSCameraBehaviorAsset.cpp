@@ -0,0 +1,69 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Character/Animation/ALSCameraBehaviorAsset.h"
+
+
+FALSCameraBehaviorParams UALSCameraBehaviorAsset::GetParams(EALSViewMode ViewMode, EALSMovementState MovementState,
+                                                            EALSRotationMode RotationMode, EALSStance Stance,
+                                                            EALSGait Gait) const
+{
+	if (bUseFirstPersonParams && ViewMode == EALSViewMode::FirstPerson)
+	{
+		return FirstPerson;
+	}
+
+	switch (MovementState)
+	{
+	case EALSMovementState::InAir:
+		if (bUseInAirParams)
+		{
+			return InAir;
+		}
+		break;
+	case EALSMovementState::Mantling:
+		if (bUseMantlingParams)
+		{
+			return Mantling;
+		}
+		break;
+	case EALSMovementState::Ragdoll:
+		if (bUseRagdollParams)
+		{
+			return Ragdoll;
+		}
+		break;
+	default:
+		break;
+	}
+
+	const FALSCameraBehaviorGaitParams* GaitParams = &ThirdPerson.VelocityDirection;
+	if (RotationMode == EALSRotationMode::LookingDirection)
+	{
+		GaitParams = &ThirdPerson.LookingDirection;
+	}
+	else if (RotationMode == EALSRotationMode::Aiming)
+	{
+		GaitParams = &ThirdPerson.Aiming;
+	}
+
+	if (Stance == EALSStance::Crouching)
+	{
+		return GaitParams->Crouching;
+	}
+
+	switch (Gait)
+	{
+	case EALSGait::Running:
+		return GaitParams->Running;
+	case EALSGait::Sprinting:
+		return GaitParams->Sprinting;
+	default:
+		return GaitParams->Walking;
+	}
+}
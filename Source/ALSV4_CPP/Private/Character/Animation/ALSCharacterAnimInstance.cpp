@@ -9,8 +9,11 @@
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Library/ALSMathLibrary.h"
+#include "Library/ALSStats.h"
 #include "Components/ALSDebugComponent.h"
+#include "Subsystems/ALSAnimationSubsystem.h"
 #include "TimerManager.h"
+#include "Animation/Skeleton.h"
 #include "Curves/CurveFloat.h"
 
 #include "Curves/CurveVector.h"
@@ -18,43 +21,194 @@
 #include "GameFramework/CharacterMovementComponent.h"
 
 
-const FName NAME_BasePose_CLF(TEXT("BasePose_CLF"));
-const FName NAME_BasePose_N(TEXT("BasePose_N"));
-const FName NAME_Enable_FootIK_R(TEXT("Enable_FootIK_R"));
-const FName NAME_Enable_FootIK_L(TEXT("Enable_FootIK_L"));
-const FName NAME_Enable_HandIK_L(TEXT("Enable_HandIK_L"));
-const FName NAME_Enable_HandIK_R(TEXT("Enable_HandIK_R"));
-const FName NAME_Enable_Transition(TEXT("Enable_Transition"));
-const FName NAME_FootLock_L(TEXT("FootLock_L"));
-const FName NAME_FootLock_R(TEXT("FootLock_R"));
+DECLARE_CYCLE_STAT(TEXT("Anim Update (No LOD Tier)"), STAT_ALSAnimUpdate_NoTier, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update (LOD Tier 0)"), STAT_ALSAnimUpdate_Tier0, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update (LOD Tier 1)"), STAT_ALSAnimUpdate_Tier1, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update (LOD Tier 2)"), STAT_ALSAnimUpdate_Tier2, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Update (LOD Tier 3+)"), STAT_ALSAnimUpdate_Tier3, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Aiming Values"), STAT_ALSAnimAimingValues, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Layer Values"), STAT_ALSAnimLayerValues, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Foot IK"), STAT_ALSAnimFootIK, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Movement Values"), STAT_ALSAnimMovementValues, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Turn In Place"), STAT_ALSAnimTurnInPlace, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Dynamic Transitions"), STAT_ALSAnimDynamicTransitions, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim In Air Values"), STAT_ALSAnimInAirValues, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Ground Traces"), STAT_ALSAnimGroundTraces, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Sync Ground Traces"), STAT_ALSAnimSyncGroundTraces, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Async Ground Traces"), STAT_ALSAnimAsyncGroundTraces, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Instances (No LOD Tier)"), STAT_ALSAnimInstances_NoTier, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Instances (LOD Tier 0)"), STAT_ALSAnimInstances_Tier0, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Instances (LOD Tier 1)"), STAT_ALSAnimInstances_Tier1, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Instances (LOD Tier 2)"), STAT_ALSAnimInstances_Tier2, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Instances (LOD Tier 3+)"), STAT_ALSAnimInstances_Tier3, STATGROUP_ALS);
+
 const FName NAME_Grounded___Slot(TEXT("Grounded Slot"));
-const FName NAME_Layering_Arm_L(TEXT("Layering_Arm_L"));
-const FName NAME_Layering_Arm_L_Add(TEXT("Layering_Arm_L_Add"));
-const FName NAME_Layering_Arm_L_LS(TEXT("Layering_Arm_L_LS"));
-const FName NAME_Layering_Arm_R(TEXT("Layering_Arm_R"));
-const FName NAME_Layering_Arm_R_Add(TEXT("Layering_Arm_R_Add"));
-const FName NAME_Layering_Arm_R_LS(TEXT("Layering_Arm_R_LS"));
-const FName NAME_Layering_Hand_L(TEXT("Layering_Hand_L"));
-const FName NAME_Layering_Hand_R(TEXT("Layering_Hand_R"));
-const FName NAME_Layering_Head_Add(TEXT("Layering_Head_Add"));
-const FName NAME_Layering_Spine_Add(TEXT("Layering_Spine_Add"));
-const FName NAME_Mask_AimOffset(TEXT("Mask_AimOffset"));
-const FName NAME_Mask_LandPrediction(TEXT("Mask_LandPrediction"));
-const FName NAME__ALSCharacterAnimInstance__RotationAmount(TEXT("RotationAmount"));
 const FName NAME_VB___foot_target_l(TEXT("VB foot_target_l"));
 const FName NAME_VB___foot_target_r(TEXT("VB foot_target_r"));
-const FName NAME_W_Gait(TEXT("W_Gait"));
 const FName NAME__ALSCharacterAnimInstance__root(TEXT("root"));
 
+/** Curve names indexed by EALSAnimCurve */
+const FName NAME_ALSAnimCurves[] =
+{
+	FName(TEXT("BasePose_CLF")),
+	FName(TEXT("BasePose_N")),
+	FName(TEXT("Enable_FootIK_L")),
+	FName(TEXT("Enable_FootIK_R")),
+	FName(TEXT("Enable_HandIK_L")),
+	FName(TEXT("Enable_HandIK_R")),
+	FName(TEXT("Enable_Transition")),
+	FName(TEXT("FootLock_L")),
+	FName(TEXT("FootLock_R")),
+	FName(TEXT("Layering_Arm_L")),
+	FName(TEXT("Layering_Arm_L_Add")),
+	FName(TEXT("Layering_Arm_L_LS")),
+	FName(TEXT("Layering_Arm_R")),
+	FName(TEXT("Layering_Arm_R_Add")),
+	FName(TEXT("Layering_Arm_R_LS")),
+	FName(TEXT("Layering_Hand_L")),
+	FName(TEXT("Layering_Hand_R")),
+	FName(TEXT("Layering_Head_Add")),
+	FName(TEXT("Layering_Spine_Add")),
+	FName(TEXT("Mask_AimOffset")),
+	FName(TEXT("Mask_LandPrediction")),
+	FName(TEXT("RotationAmount")),
+	FName(TEXT("W_Gait")),
+};
+
+static_assert(UE_ARRAY_COUNT(NAME_ALSAnimCurves) == static_cast<int32>(EALSAnimCurve::MAX),
+              "Every EALSAnimCurve needs a curve name");
+static_assert(static_cast<int32>(EALSAnimCurve::MAX) <= 32, "ALS curve masks are 32 bit");
+
 
 FName UALSCharacterAnimInstance::NAME_ik_foot_l(TEXT("ik_foot_l"));
 FName UALSCharacterAnimInstance::NAME_ik_foot_r(TEXT("ik_foot_r"));
 
 
+void FALSAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	// Still on the game thread, the update only reads this snapshot and never the anim instance's curves
+	UALSCharacterAnimInstance* AnimInstance = CastChecked<UALSCharacterAnimInstance>(InAnimInstance);
+	if (AnimInstance->Character && DeltaSeconds != 0.0f)
+	{
+		AnimInstance->GatherCharacterInformation(DeltaSeconds);
+	}
+}
+
+void FALSAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	UALSCharacterAnimInstance* AnimInstance = CastChecked<UALSCharacterAnimInstance>(GetAnimInstanceObject());
+	if (AnimInstance->bAnimationValuesPending)
+	{
+		AnimInstance->bAnimationValuesPending = false;
+		AnimInstance->UpdateAnimationValues(AnimInstance->UpdateSnapshot.DeltaSeconds);
+	}
+}
+
+void FALSAnimInstanceProxy::PostUpdate(UAnimInstance* InAnimInstance) const
+{
+	Super::PostUpdate(InAnimInstance);
+
+	// Montages can only be played on the game thread
+	CastChecked<UALSCharacterAnimInstance>(InAnimInstance)->PlayPendingTurnInPlace();
+}
+
+
+namespace
+{
+	FORCEINLINE void StoreVelocityBlend(const VectorRegister& Blend, FALSVelocityBlend& OutBlend)
+	{
+		float Channels[4];
+		VectorStore(Blend, Channels);
+		OutBlend.F = Channels[0];
+		OutBlend.B = Channels[1];
+		OutBlend.L = Channels[2];
+		OutBlend.R = Channels[3];
+	}
+
+	/** Interpolates both lean channels with one vector interpolation */
+	FORCEINLINE void InterpLeanAmount(FALSLeanAmount& LeanAmount, float TargetLR, float TargetFB, float DeltaSeconds,
+	                                  float InterpSpeed)
+	{
+		float Channels[4];
+		VectorStore(UALSMathLibrary::VectorInterpTo(MakeVectorRegister(LeanAmount.LR, LeanAmount.FB, 0.0f, 0.0f),
+		                                            MakeVectorRegister(TargetLR, TargetFB, 0.0f, 0.0f),
+		                                            DeltaSeconds, InterpSpeed), Channels);
+		LeanAmount.LR = Channels[0];
+		LeanAmount.FB = Channels[1];
+	}
+
+	constexpr uint32 CurveBit(EALSAnimCurve Curve)
+	{
+		return 1u << static_cast<uint32>(Curve);
+	}
+
+	/** Curves read by the layer values update */
+	constexpr uint32 LayerValueCurves =
+		CurveBit(EALSAnimCurve::Mask_AimOffset) | CurveBit(EALSAnimCurve::BasePose_N) |
+		CurveBit(EALSAnimCurve::BasePose_CLF) | CurveBit(EALSAnimCurve::Layering_Spine_Add) |
+		CurveBit(EALSAnimCurve::Layering_Head_Add) | CurveBit(EALSAnimCurve::Layering_Arm_L_Add) |
+		CurveBit(EALSAnimCurve::Layering_Arm_R_Add) | CurveBit(EALSAnimCurve::Layering_Hand_L) |
+		CurveBit(EALSAnimCurve::Layering_Hand_R) | CurveBit(EALSAnimCurve::Enable_HandIK_L) |
+		CurveBit(EALSAnimCurve::Enable_HandIK_R) | CurveBit(EALSAnimCurve::Layering_Arm_L) |
+		CurveBit(EALSAnimCurve::Layering_Arm_R) | CurveBit(EALSAnimCurve::Layering_Arm_L_LS) |
+		CurveBit(EALSAnimCurve::Layering_Arm_R_LS);
+
+	/** Curves read by the pelvis offset, also while foot IK blends out */
+	constexpr uint32 FootIKEnableCurves =
+		CurveBit(EALSAnimCurve::Enable_FootIK_L) | CurveBit(EALSAnimCurve::Enable_FootIK_R);
+
+	/** Curves read by the foot locking */
+	constexpr uint32 FootLockCurves =
+		CurveBit(EALSAnimCurve::FootLock_L) | CurveBit(EALSAnimCurve::FootLock_R) |
+		CurveBit(EALSAnimCurve::RotationAmount);
+
+	/** Curves read by the grounded transitions and movement values */
+	constexpr uint32 GroundedCurves =
+		CurveBit(EALSAnimCurve::Enable_Transition) | CurveBit(EALSAnimCurve::W_Gait) |
+		CurveBit(EALSAnimCurve::BasePose_CLF);
+
+	/** Counts the instance on its tier and returns the cycle stat the tier's update time is tracked under */
+	TStatId TrackAnimLODTier(int32 LODTier)
+	{
+		switch (LODTier)
+		{
+		case INDEX_NONE:
+			INC_DWORD_STAT(STAT_ALSAnimInstances_NoTier);
+			return GET_STATID(STAT_ALSAnimUpdate_NoTier);
+		case 0:
+			INC_DWORD_STAT(STAT_ALSAnimInstances_Tier0);
+			return GET_STATID(STAT_ALSAnimUpdate_Tier0);
+		case 1:
+			INC_DWORD_STAT(STAT_ALSAnimInstances_Tier1);
+			return GET_STATID(STAT_ALSAnimUpdate_Tier1);
+		case 2:
+			INC_DWORD_STAT(STAT_ALSAnimInstances_Tier2);
+			return GET_STATID(STAT_ALSAnimUpdate_Tier2);
+		default:
+			INC_DWORD_STAT(STAT_ALSAnimInstances_Tier3);
+			return GET_STATID(STAT_ALSAnimUpdate_Tier3);
+		}
+	}
+}
+
+
 void UALSCharacterAnimInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 	Character = Cast<AALSBaseCharacter>(TryGetPawnOwner());
+
+	// Resolve the curve names once, the update reads the evaluated curves of the mesh by UID
+	for (int32 Index = 0; Index < static_cast<int32>(EALSAnimCurve::MAX); ++Index)
+	{
+		CurveUIDs[Index] = CurrentSkeleton
+			                   ? CurrentSkeleton->GetUIDByName(USkeleton::AnimCurveMappingName,
+			                                                   NAME_ALSAnimCurves[Index])
+			                   : SmartName::MaxUID;
+	}
 }
 
 void UALSCharacterAnimInstance::NativeBeginPlay()
@@ -66,12 +220,73 @@ void UALSCharacterAnimInstance::NativeBeginPlay()
 	{
 		DebugComponent = Owner->FindComponentByClass<UALSDebugComponent>();
 	}
+
+	if (bUseBatchedUpdate && Character)
+	{
+		if (UALSAnimationSubsystem* AnimationSubsystem = GetWorld()->GetSubsystem<UALSAnimationSubsystem>())
+		{
+			AnimationSubsystem->RegisterAnimInstance(this);
+		}
+	}
+}
+
+void UALSCharacterAnimInstance::NativeUninitializeAnimation()
+{
+	if (bUseBatchedUpdate)
+	{
+		UWorld* World = GetWorld();
+		if (UALSAnimationSubsystem* AnimationSubsystem = World ? World->GetSubsystem<UALSAnimationSubsystem>() : nullptr)
+		{
+			AnimationSubsystem->UnregisterAnimInstance(this);
+		}
+	}
+
+	Super::NativeUninitializeAnimation();
+}
+
+void UALSCharacterAnimInstance::SetUseBatchedUpdate(bool bEnable)
+{
+	if (bUseBatchedUpdate == bEnable)
+	{
+		return;
+	}
+
+	bUseBatchedUpdate = bEnable;
+
+	// Instances without a character yet register on begin play
+	UWorld* World = GetWorld();
+	UALSAnimationSubsystem* AnimationSubsystem = World ? World->GetSubsystem<UALSAnimationSubsystem>() : nullptr;
+	if (!AnimationSubsystem || !Character)
+	{
+		return;
+	}
+
+	if (bEnable)
+	{
+		AnimationSubsystem->RegisterAnimInstance(this);
+	}
+	else
+	{
+		AnimationSubsystem->UnregisterAnimInstance(this);
+	}
+}
+
+FAnimInstanceProxy* UALSCharacterAnimInstance::CreateAnimInstanceProxy()
+{
+	return new FALSAnimInstanceProxy(this);
+}
+
+void UALSCharacterAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	delete static_cast<FALSAnimInstanceProxy*>(InProxy);
 }
 
 void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
+	bAnimationValuesPending = false;
+
 	if (!Character || DeltaSeconds == 0.0f)
 	{
 		// Fix character looking right on editor
@@ -81,15 +296,123 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		return;
 	}
 
-	// Update rest of character information. Others are reflected into anim bp when they're set inside character class
-	CharacterInformation.Velocity = Character->GetCharacterMovement()->Velocity;
+	// Character information, LOD tier and curves were gathered by the anim instance proxy's PreUpdate
+	UpdateSnapshot.DeltaSeconds = DeltaSeconds;
+
+	const FALSAnimLODTier& LODTier = GetCurrentLODTier();
+	FScopeCycleCounter LODTierCycleCounter(TrackAnimLODTier(CurrentLODTier));
+
+	// World traces, socket reads and montages stay on the game thread
+	if (!LODTier.bUpdateFootIK)
+	{
+		// Release the foot locks and blend the offsets out while foot IK is disabled on this tier
+		FootIKValues.FootLock_L_Alpha = 0.0f;
+		FootIKValues.FootLock_R_Alpha = 0.0f;
+		SetPelvisIKOffset(DeltaSeconds, FVector::ZeroVector, FVector::ZeroVector);
+		ResetIKOffsets(DeltaSeconds);
+	}
+	else if (bReducedRateFrame)
+	{
+		UpdateFootIK(ReducedRateDeltaSeconds);
+	}
+
+	if (MovementState.Grounded())
+	{
+		if (!ShouldMoveCheck() && LODTier.bUpdateDynamicTransitions && CanDynamicTransition())
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ALSAnimDynamicTransitions);
+			DynamicTransitionCheck();
+		}
+	}
+	else if (MovementState.InAir())
+	{
+		// Update the fall speed. Setting this value only while in the air allows you to use it within the AnimGraph for the landing strength.
+		// If not, the Z velocity would return to 0 on landing.
+		InAir.FallSpeed = CharacterInformation.Velocity.Z;
+
+		// Set the Land Prediction weight.
+		InAir.LandPrediction = LODTier.bUpdateLandPrediction ? CalculateLandPrediction() : 0.0f;
+	}
+	else if (MovementState.Ragdoll())
+	{
+		UpdateSnapshot.RagdollSpeed = GetOwningComponent()->GetPhysicsLinearVelocity(
+			NAME__ALSCharacterAnimInstance__root).Size();
+	}
+
+	if (bUseThreadSafeUpdate)
+	{
+		// Picked up by the anim instance proxy, on a worker thread if the anim blueprint allows it
+		bAnimationValuesPending = true;
+		return;
+	}
+
+	UpdateAnimationValues(DeltaSeconds);
+	PlayPendingTurnInPlace();
+}
+
+void UALSCharacterAnimInstance::GatherCharacterInformation(float DeltaSeconds)
+{
+	if (GatheredFrame == GFrameCounter)
+	{
+		return;
+	}
+	GatheredFrame = GFrameCounter;
+
+	// Apply the character state set since the last update, the update possibly running on a worker thread only reads
+	// the members below
+	CharacterInformation = CharacterState.CharacterInformation;
+	MovementState = CharacterState.MovementState;
+	MovementAction = CharacterState.MovementAction;
+	RotationMode = CharacterState.RotationMode;
+	Gait = CharacterState.Gait;
+	Stance = CharacterState.Stance;
+	OverlayState = CharacterState.OverlayState;
+	InAir.bJumped = CharacterState.bJumped;
+	InAir.JumpPlayRate = CharacterState.JumpPlayRate;
+
+	// Update rest of character information
+	const UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	CharacterInformation.Velocity = CharacterMovement->Velocity;
 	CharacterInformation.MovementInput = Character->GetMovementInput();
 	CharacterInformation.AimingRotation = Character->GetAimingRotation();
 	CharacterInformation.CharacterActorRotation = Character->GetActorRotation();
 
+	UpdateLODTier();
+
+	// Reduced rate features get the frame time accumulated since their last update
+	const FALSAnimLODTier& LODTier = GetCurrentLODTier();
+	ReducedRateDeltaSeconds = DeltaSeconds;
+	bReducedRateFrame = true;
+	if (LODTier.ReducedRateInterval > 1)
+	{
+		SkippedDeltaSeconds += DeltaSeconds;
+		bReducedRateFrame = ++SkippedFrameCount >= LODTier.ReducedRateInterval;
+	}
+	if (bReducedRateFrame)
+	{
+		ReducedRateDeltaSeconds = FMath::Max(SkippedDeltaSeconds, DeltaSeconds);
+		SkippedDeltaSeconds = 0.0f;
+		SkippedFrameCount = 0;
+	}
+
+	UpdateCurveValues();
+
+	// Gather the remaining game thread data the animation values update reads
+	UpdateSnapshot.MaxAcceleration = CharacterMovement->GetMaxAcceleration();
+	UpdateSnapshot.MaxBrakingDeceleration = CharacterMovement->GetMaxBrakingDeceleration();
+	UpdateSnapshot.MeshScaleZ = GetOwningComponent()->GetComponentScale().Z;
+}
+
+void UALSCharacterAnimInstance::UpdateAnimationValues(float DeltaSeconds)
+{
+	const FALSAnimLODTier& LODTier = GetCurrentLODTier();
+
 	UpdateAimingValues(DeltaSeconds);
-	UpdateLayerValues();
-	UpdateFootIK(DeltaSeconds);
+
+	if (LODTier.bUpdateLayerValues && bReducedRateFrame)
+	{
+		UpdateLayerValues();
+	}
 
 	if (MovementState.Grounded())
 	{
@@ -109,12 +432,12 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		{
 			// Do While Moving
 			UpdateMovementValues(DeltaSeconds);
-			UpdateRotationValues();
 		}
 		else
 		{
 			// Do While Not Moving
-			if (CanRotateInPlace())
+			SCOPE_CYCLE_COUNTER(STAT_ALSAnimTurnInPlace);
+			if (LODTier.bUpdateTurnInPlace && CanRotateInPlace())
 			{
 				RotateInPlaceCheck();
 			}
@@ -123,7 +446,7 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 				Grounded.bRotateL = false;
 				Grounded.bRotateR = false;
 			}
-			if (CanTurnInPlace())
+			if (LODTier.bUpdateTurnInPlace && CanTurnInPlace())
 			{
 				TurnInPlaceCheck(DeltaSeconds);
 			}
@@ -131,16 +454,12 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 			{
 				TurnInPlaceValues.ElapsedDelayTime = 0.0f;
 			}
-			if (CanDynamicTransition())
-			{
-				DynamicTransitionCheck();
-			}
 		}
 	}
 	else if (MovementState.InAir())
 	{
 		// Do While InAir
-		UpdateInAirValues(DeltaSeconds);
+		UpdateMovementValues(DeltaSeconds);
 	}
 	else if (MovementState.Ragdoll())
 	{
@@ -149,6 +468,55 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 	}
 }
 
+void UALSCharacterAnimInstance::PlayPendingTurnInPlace()
+{
+	if (bTurnInPlacePending)
+	{
+		bTurnInPlacePending = false;
+		TurnInPlace(PendingTurnInPlaceRotation, 1.0f, 0.0f, false);
+	}
+}
+
+const FALSAnimLODTier& UALSCharacterAnimInstance::GetCurrentLODTier() const
+{
+	// Without a matching tier everything updates every frame
+	static const FALSAnimLODTier FullLODTier;
+	return CurrentLODTier != INDEX_NONE ? LODTiers[CurrentLODTier] : FullLODTier;
+}
+
+void UALSCharacterAnimInstance::UpdateLODTier()
+{
+	CurrentLODTier = INDEX_NONE;
+	if (LODTiers.Num() == 0)
+	{
+		return;
+	}
+
+	// Tiers are sorted by ascending threshold, so the last reached one wins
+	const float MetricValue = GetLODMetricValue();
+	for (int32 Index = 0; Index < LODTiers.Num(); ++Index)
+	{
+		if (MetricValue >= LODTiers[Index].MinMetricValue)
+		{
+			CurrentLODTier = Index;
+		}
+	}
+}
+
+float UALSCharacterAnimInstance::GetLODMetricValue() const
+{
+	const USkeletalMeshComponent* OwnerComp = GetOwningComponent();
+	switch (LODMetric)
+	{
+	case EALSAnimLODMetric::MeshLOD:
+		return static_cast<float>(OwnerComp->GetPredictedLODLevel());
+	case EALSAnimLODMetric::UpdateRate:
+		return OwnerComp->AnimUpdateRateParams ? static_cast<float>(OwnerComp->AnimUpdateRateParams->UpdateRate) : 1.0f;
+	default:
+		return UALSMathLibrary::GetClosestViewDistance(GetWorld(), OwnerComp->GetComponentLocation());
+	}
+}
+
 void UALSCharacterAnimInstance::PlayTransition(const FALSDynamicMontageParams& Parameters)
 {
 	PlaySlotAnimationAsDynamicMontage(Parameters.Animation, NAME_Grounded___Slot,
@@ -197,12 +565,12 @@ bool UALSCharacterAnimInstance::CanTurnInPlace() const
 {
 	return RotationMode.LookingDirection() &&
 		CharacterInformation.ViewMode == EALSViewMode::ThirdPerson &&
-		GetCurveValue(NAME_Enable_Transition) >= 0.99f;
+		GetCachedCurveValue(EALSAnimCurve::Enable_Transition) >= 0.99f;
 }
 
 bool UALSCharacterAnimInstance::CanDynamicTransition() const
 {
-	return GetCurveValue(NAME_Enable_Transition) >= 0.99f;
+	return GetCachedCurveValue(EALSAnimCurve::Enable_Transition) >= 0.99f;
 }
 
 void UALSCharacterAnimInstance::PlayDynamicTransitionDelay()
@@ -212,7 +580,7 @@ void UALSCharacterAnimInstance::PlayDynamicTransitionDelay()
 
 void UALSCharacterAnimInstance::OnJumpedDelay()
 {
-	InAir.bJumped = false;
+	CharacterState.bJumped = false;
 }
 
 void UALSCharacterAnimInstance::OnPivotDelay()
@@ -222,6 +590,8 @@ void UALSCharacterAnimInstance::OnPivotDelay()
 
 void UALSCharacterAnimInstance::UpdateAimingValues(float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALSAnimAimingValues);
+
 	// Interp the Aiming Rotation value to achieve smooth aiming rotation changes.
 	// Interpolating the rotation before calculating the angle ensures the value is not affected by changes
 	// in actor rotation, allowing slow aiming rotation changes with fast actor rotation changes.
@@ -279,42 +649,46 @@ void UALSCharacterAnimInstance::UpdateAimingValues(float DeltaSeconds)
 
 void UALSCharacterAnimInstance::UpdateLayerValues()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALSAnimLayerValues);
+
 	// Get the Aim Offset weight by getting the opposite of the Aim Offset Mask.
-	LayerBlendingValues.EnableAimOffset = FMath::Lerp(1.0f, 0.0f, GetCurveValue(NAME_Mask_AimOffset));
+	LayerBlendingValues.EnableAimOffset = FMath::Lerp(1.0f, 0.0f, GetCachedCurveValue(EALSAnimCurve::Mask_AimOffset));
 	// Set the Base Pose weights
-	LayerBlendingValues.BasePose_N = GetCurveValue(NAME_BasePose_N);
-	LayerBlendingValues.BasePose_CLF = GetCurveValue(NAME_BasePose_CLF);
+	LayerBlendingValues.BasePose_N = GetCachedCurveValue(EALSAnimCurve::BasePose_N);
+	LayerBlendingValues.BasePose_CLF = GetCachedCurveValue(EALSAnimCurve::BasePose_CLF);
 	// Set the Additive amount weights for each body part
-	LayerBlendingValues.Spine_Add = GetCurveValue(NAME_Layering_Spine_Add);
-	LayerBlendingValues.Head_Add = GetCurveValue(NAME_Layering_Head_Add);
-	LayerBlendingValues.Arm_L_Add = GetCurveValue(NAME_Layering_Arm_L_Add);
-	LayerBlendingValues.Arm_R_Add = GetCurveValue(NAME_Layering_Arm_R_Add);
+	LayerBlendingValues.Spine_Add = GetCachedCurveValue(EALSAnimCurve::Layering_Spine_Add);
+	LayerBlendingValues.Head_Add = GetCachedCurveValue(EALSAnimCurve::Layering_Head_Add);
+	LayerBlendingValues.Arm_L_Add = GetCachedCurveValue(EALSAnimCurve::Layering_Arm_L_Add);
+	LayerBlendingValues.Arm_R_Add = GetCachedCurveValue(EALSAnimCurve::Layering_Arm_R_Add);
 	// Set the Hand Override weights
-	LayerBlendingValues.Hand_R = GetCurveValue(NAME_Layering_Hand_R);
-	LayerBlendingValues.Hand_L = GetCurveValue(NAME_Layering_Hand_L);
+	LayerBlendingValues.Hand_R = GetCachedCurveValue(EALSAnimCurve::Layering_Hand_R);
+	LayerBlendingValues.Hand_L = GetCachedCurveValue(EALSAnimCurve::Layering_Hand_L);
 	// Blend and set the Hand IK weights to ensure they only are weighted if allowed by the Arm layers.
-	LayerBlendingValues.EnableHandIK_L = FMath::Lerp(0.0f, GetCurveValue(NAME_Enable_HandIK_L),
-	                                                 GetCurveValue(NAME_Layering_Arm_L));
-	LayerBlendingValues.EnableHandIK_R = FMath::Lerp(0.0f, GetCurveValue(NAME_Enable_HandIK_R),
-	                                                 GetCurveValue(NAME_Layering_Arm_R));
+	LayerBlendingValues.EnableHandIK_L = FMath::Lerp(0.0f, GetCachedCurveValue(EALSAnimCurve::Enable_HandIK_L),
+	                                                 GetCachedCurveValue(EALSAnimCurve::Layering_Arm_L));
+	LayerBlendingValues.EnableHandIK_R = FMath::Lerp(0.0f, GetCachedCurveValue(EALSAnimCurve::Enable_HandIK_R),
+	                                                 GetCachedCurveValue(EALSAnimCurve::Layering_Arm_R));
 	// Set whether the arms should blend in mesh space or local space.
 	// The Mesh space weight will always be 1 unless the Local Space (LS) curve is fully weighted.
-	LayerBlendingValues.Arm_L_LS = GetCurveValue(NAME_Layering_Arm_L_LS);
+	LayerBlendingValues.Arm_L_LS = GetCachedCurveValue(EALSAnimCurve::Layering_Arm_L_LS);
 	LayerBlendingValues.Arm_L_MS = static_cast<float>(1 - FMath::FloorToInt(LayerBlendingValues.Arm_L_LS));
-	LayerBlendingValues.Arm_R_LS = GetCurveValue(NAME_Layering_Arm_R_LS);
+	LayerBlendingValues.Arm_R_LS = GetCachedCurveValue(EALSAnimCurve::Layering_Arm_R_LS);
 	LayerBlendingValues.Arm_R_MS = static_cast<float>(1 - FMath::FloorToInt(LayerBlendingValues.Arm_R_LS));
 }
 
 void UALSCharacterAnimInstance::UpdateFootIK(float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALSAnimFootIK);
+
 	FVector FootOffsetLTarget = FVector::ZeroVector;
 	FVector FootOffsetRTarget = FVector::ZeroVector;
 
 	// Update Foot Locking values.
-	SetFootLocking(DeltaSeconds, NAME_Enable_FootIK_L, NAME_FootLock_L,
+	SetFootLocking(DeltaSeconds, EALSAnimCurve::Enable_FootIK_L, EALSAnimCurve::FootLock_L,
 	               IkFootL_BoneName, FootIKValues.FootLock_L_Alpha, FootIKValues.UseFootLockCurve_L,
 	               FootIKValues.FootLock_L_Location, FootIKValues.FootLock_L_Rotation);
-	SetFootLocking(DeltaSeconds, NAME_Enable_FootIK_R, NAME_FootLock_R,
+	SetFootLocking(DeltaSeconds, EALSAnimCurve::Enable_FootIK_R, EALSAnimCurve::FootLock_R,
 	               IkFootR_BoneName, FootIKValues.FootLock_R_Alpha, FootIKValues.UseFootLockCurve_R,
 	               FootIKValues.FootLock_R_Location, FootIKValues.FootLock_R_Rotation);
 
@@ -327,21 +701,22 @@ void UALSCharacterAnimInstance::UpdateFootIK(float DeltaSeconds)
 	else if (!MovementState.Ragdoll())
 	{
 		// Update all Foot Lock and Foot Offset values when not In Air
-		SetFootOffsets(DeltaSeconds, NAME_Enable_FootIK_L, IkFootL_BoneName, NAME__ALSCharacterAnimInstance__root,
+		SetFootOffsets(DeltaSeconds, EALSAnimCurve::Enable_FootIK_L, IkFootL_BoneName, NAME__ALSCharacterAnimInstance__root,
 		               FootOffsetLTarget,
-		               FootIKValues.FootOffset_L_Location, FootIKValues.FootOffset_L_Rotation);
-		SetFootOffsets(DeltaSeconds, NAME_Enable_FootIK_R, IkFootR_BoneName, NAME__ALSCharacterAnimInstance__root,
+		               FootIKValues.FootOffset_L_Location, FootIKValues.FootOffset_L_Rotation, FootTraceHandle_L);
+		SetFootOffsets(DeltaSeconds, EALSAnimCurve::Enable_FootIK_R, IkFootR_BoneName, NAME__ALSCharacterAnimInstance__root,
 		               FootOffsetRTarget,
-		               FootIKValues.FootOffset_R_Location, FootIKValues.FootOffset_R_Rotation);
+		               FootIKValues.FootOffset_R_Location, FootIKValues.FootOffset_R_Rotation, FootTraceHandle_R);
 		SetPelvisIKOffset(DeltaSeconds, FootOffsetLTarget, FootOffsetRTarget);
 	}
 }
 
-void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableFootIKCurve, FName FootLockCurve,
+void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve,
+                                               EALSAnimCurve FootLockCurve,
                                                FName IKFootBone, float& CurFootLockAlpha, bool& UseFootLockCurve,
                                                FVector& CurFootLockLoc, FRotator& CurFootLockRot)
 {
-	if (GetCurveValue(EnableFootIKCurve) <= 0.0f)
+	if (GetCachedCurveValue(EnableFootIKCurve) <= 0.0f)
 	{
 		return;
 	}
@@ -351,13 +726,13 @@ void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableF
 
 	if (UseFootLockCurve)
 	{
-		UseFootLockCurve = FMath::Abs(GetCurveValue(NAME__ALSCharacterAnimInstance__RotationAmount)) <= 0.001f ||
+		UseFootLockCurve = FMath::Abs(GetCachedCurveValue(EALSAnimCurve::RotationAmount)) <= 0.001f ||
 			Character->GetLocalRole() != ROLE_AutonomousProxy;
-		FootLockCurveVal = GetCurveValue(FootLockCurve) * (1.f / GetSkelMeshComponent()->AnimUpdateRateParams->UpdateRate);
+		FootLockCurveVal = GetCachedCurveValue(FootLockCurve) * (1.f / GetSkelMeshComponent()->AnimUpdateRateParams->UpdateRate);
 	}
 	else
 	{
-		UseFootLockCurve = GetCurveValue(FootLockCurve) >= 0.99f;
+		UseFootLockCurve = GetCachedCurveValue(FootLockCurve) >= 0.99f;
 		FootLockCurveVal = 0.0f;
 	}
 
@@ -417,7 +792,7 @@ void UALSCharacterAnimInstance::SetPelvisIKOffset(float DeltaSeconds, FVector Fo
 {
 	// Calculate the Pelvis Alpha by finding the average Foot IK weight. If the alpha is 0, clear the offset.
 	FootIKValues.PelvisAlpha =
-		(GetCurveValue(NAME_Enable_FootIK_L) + GetCurveValue(NAME_Enable_FootIK_R)) / 2.0f;
+		(GetCachedCurveValue(EALSAnimCurve::Enable_FootIK_L) + GetCachedCurveValue(EALSAnimCurve::Enable_FootIK_R)) / 2.0f;
 
 	if (FootIKValues.PelvisAlpha > 0.0f)
 	{
@@ -449,12 +824,12 @@ void UALSCharacterAnimInstance::ResetIKOffsets(float DeltaSeconds)
 	                                                      FRotator::ZeroRotator, DeltaSeconds, 15.0f);
 }
 
-void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, FName EnableFootIKCurve, FName IKFootBone,
+void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve, FName IKFootBone,
                                                FName RootBone, FVector& CurLocationTarget, FVector& CurLocationOffset,
-                                               FRotator& CurRotationOffset)
+                                               FRotator& CurRotationOffset, FTraceHandle& TraceHandle)
 {
 	// Only update Foot IK offset values if the Foot IK curve has a weight. If it equals 0, clear the offset values.
-	if (GetCurveValue(EnableFootIKCurve) <= 0)
+	if (GetCachedCurveValue(EnableFootIKCurve) <= 0)
 	{
 		CurLocationOffset = FVector::ZeroVector;
 		CurRotationOffset = FRotator::ZeroRotator;
@@ -467,25 +842,16 @@ void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, FName EnableF
 	FVector IKFootFloorLoc = OwnerComp->GetSocketLocation(IKFootBone);
 	IKFootFloorLoc.Z = OwnerComp->GetSocketLocation(RootBone).Z;
 
-	UWorld* World = GetWorld();
-	check(World);
-
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(Character);
-
 	const FVector TraceStart = IKFootFloorLoc + FVector(0.0, 0.0, Config.IK_TraceDistanceAboveFoot);
 	const FVector TraceEnd = IKFootFloorLoc - FVector(0.0, 0.0, Config.IK_TraceDistanceBelowFoot);
 
 	FHitResult HitResult;
-	const bool bHit = World->LineTraceSingleByChannel(HitResult,
-	                                                  TraceStart,
-	                                                  TraceEnd,
-	                                                  ECC_Visibility, Params);
+	const bool bHit = TraceGround(TraceHandle, TraceStart, TraceEnd, FCollisionShape(), HitResult);
 
 	if (DebugComponent && DebugComponent->GetShowTraces())
 	{
 		UALSDebugComponent::DrawDebugLineTraceSingle(
-			World,
+			GetWorld(),
 			TraceStart,
 			TraceEnd,
 			EDrawDebugTrace::Type::ForOneFrame,
@@ -562,10 +928,11 @@ void UALSCharacterAnimInstance::TurnInPlaceCheck(float DeltaSeconds)
 	// Step 2: Check if the Elapsed Delay time exceeds the set delay (mapped to the turn angle range). If so, trigger a Turn In Place.
 	if (TurnInPlaceValues.ElapsedDelayTime > ClampedAimAngle)
 	{
-		FRotator TurnInPlaceYawRot = CharacterInformation.AimingRotation;
-		TurnInPlaceYawRot.Roll = 0.0f;
-		TurnInPlaceYawRot.Pitch = 0.0f;
-		TurnInPlace(TurnInPlaceYawRot, 1.0f, 0.0f, false);
+		// The turn montage is played on the game thread once the update finishes
+		bTurnInPlacePending = true;
+		PendingTurnInPlaceRotation = CharacterInformation.AimingRotation;
+		PendingTurnInPlaceRotation.Roll = 0.0f;
+		PendingTurnInPlaceRotation.Pitch = 0.0f;
 	}
 }
 
@@ -607,174 +974,305 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 
 void UALSCharacterAnimInstance::UpdateMovementValues(float DeltaSeconds)
 {
-	// Interp and set the Velocity Blend.
-	const FALSVelocityBlend& TargetBlend = CalculateVelocityBlend();
-	VelocityBlend.F = FMath::FInterpTo(VelocityBlend.F, TargetBlend.F, DeltaSeconds, Config.VelocityBlendInterpSpeed);
-	VelocityBlend.B = FMath::FInterpTo(VelocityBlend.B, TargetBlend.B, DeltaSeconds, Config.VelocityBlendInterpSpeed);
-	VelocityBlend.L = FMath::FInterpTo(VelocityBlend.L, TargetBlend.L, DeltaSeconds, Config.VelocityBlendInterpSpeed);
-	VelocityBlend.R = FMath::FInterpTo(VelocityBlend.R, TargetBlend.R, DeltaSeconds, Config.VelocityBlendInterpSpeed);
+	if (BatchedMovementValuesFrame == GFrameCounter)
+	{
+		// Already computed by the animation subsystem this frame
+		return;
+	}
+
+	FScopeCycleCounter MovementValuesCycleCounter(MovementState.Grounded()
+		                                              ? GET_STATID(STAT_ALSAnimMovementValues)
+		                                              : GET_STATID(STAT_ALSAnimInAirValues));
+
+	FALSAnimMovementInput Input;
+	if (!GatherMovementInput(DeltaSeconds, Input))
+	{
+		return;
+	}
+
+	FALSAnimMovementValues Values;
+	GatherMovementValues(Values);
+	CalculateMovementValues(Input, Values);
+	ApplyMovementValues(Values);
+}
+
+bool UALSCharacterAnimInstance::GatherMovementInput(float DeltaSeconds, FALSAnimMovementInput& Input) const
+{
+	if (MovementState.Grounded())
+	{
+		if (!ShouldMoveCheck())
+		{
+			return false;
+		}
+		Input.bGrounded = true;
+	}
+	else if (MovementState.InAir())
+	{
+		Input.bGrounded = false;
+	}
+	else
+	{
+		return false;
+	}
+
+	Input.DeltaSeconds = DeltaSeconds;
+	Input.Velocity = CharacterInformation.Velocity;
+	Input.Acceleration = CharacterInformation.Acceleration;
+	Input.ActorQuat = CharacterInformation.CharacterActorRotation.Quaternion();
+	Input.AimingRotation = CharacterInformation.AimingRotation;
+	Input.Speed = CharacterInformation.Speed;
+	Input.MaxAcceleration = UpdateSnapshot.MaxAcceleration;
+	Input.MaxBrakingDeceleration = UpdateSnapshot.MaxBrakingDeceleration;
+	Input.MeshScaleZ = UpdateSnapshot.MeshScaleZ;
+	Input.FallSpeed = CharacterInformation.Velocity.Z;
+	Input.GaitCurve = GetCachedCurveValue(EALSAnimCurve::W_Gait);
+	Input.BasePoseCLFCurve = GetCachedCurveValue(EALSAnimCurve::BasePose_CLF);
+	Input.Gait = Gait;
+	Input.RotationMode = RotationMode;
+	Input.bUpdateLean = GetCurrentLODTier().bUpdateLean;
+	return true;
+}
+
+void UALSCharacterAnimInstance::GatherMovementValues(FALSAnimMovementValues& Values) const
+{
+	Values.VelocityBlend = VelocityBlend;
+	Values.LeanAmount = LeanAmount;
+	Values.RelativeAccelerationAmount = RelativeAccelerationAmount;
+	Values.MovementDirection = MovementDirection;
+	Values.DiagonalScaleAmount = Grounded.DiagonalScaleAmount;
+	Values.WalkRunBlend = Grounded.WalkRunBlend;
+	Values.StrideBlend = Grounded.StrideBlend;
+	Values.StandingPlayRate = Grounded.StandingPlayRate;
+	Values.CrouchingPlayRate = Grounded.CrouchingPlayRate;
+	Values.FYaw = Grounded.FYaw;
+	Values.BYaw = Grounded.BYaw;
+	Values.LYaw = Grounded.LYaw;
+	Values.RYaw = Grounded.RYaw;
+}
+
+void UALSCharacterAnimInstance::ApplyMovementValues(const FALSAnimMovementValues& Values)
+{
+	VelocityBlend = Values.VelocityBlend;
+	LeanAmount = Values.LeanAmount;
+	RelativeAccelerationAmount = Values.RelativeAccelerationAmount;
+	MovementDirection = Values.MovementDirection;
+	Grounded.DiagonalScaleAmount = Values.DiagonalScaleAmount;
+	Grounded.WalkRunBlend = Values.WalkRunBlend;
+	Grounded.StrideBlend = Values.StrideBlend;
+	Grounded.StandingPlayRate = Values.StandingPlayRate;
+	Grounded.CrouchingPlayRate = Values.CrouchingPlayRate;
+	Grounded.FYaw = Values.FYaw;
+	Grounded.BYaw = Values.BYaw;
+	Grounded.LYaw = Values.LYaw;
+	Grounded.RYaw = Values.RYaw;
+}
+
+void UALSCharacterAnimInstance::ApplyBatchedMovementValues(const FALSAnimMovementValues& Values)
+{
+	ApplyMovementValues(Values);
+	BatchedMovementValuesFrame = GFrameCounter;
+}
+
+void UALSCharacterAnimInstance::CalculateMovementValues(const FALSAnimMovementInput& Input,
+                                                        FALSAnimMovementValues& Values) const
+{
+	const float DeltaSeconds = Input.DeltaSeconds;
+
+	if (!Input.bGrounded)
+	{
+		// Interp and set the In Air Lean Amount
+		if (!Input.bUpdateLean)
+		{
+			Values.LeanAmount = FALSLeanAmount();
+			return;
+		}
+
+		const FALSLeanAmount& InAirLeanAmount = CalculateAirLeanAmount(Input);
+		InterpLeanAmount(Values.LeanAmount, InAirLeanAmount.LR, InAirLeanAmount.FB, DeltaSeconds,
+		                 Config.GroundedLeanInterpSpeed);
+		return;
+	}
+
+	// Interp and set the Velocity Blend, all four channels at once.
+	const VectorRegister CurrentBlend = MakeVectorRegister(Values.VelocityBlend.F, Values.VelocityBlend.B,
+	                                                       Values.VelocityBlend.L, Values.VelocityBlend.R);
+	StoreVelocityBlend(UALSMathLibrary::VectorInterpTo(CurrentBlend, CalculateVelocityBlend(Input), DeltaSeconds,
+	                                                   Config.VelocityBlendInterpSpeed), Values.VelocityBlend);
 
 	// Set the Diagonal Scale Amount.
-	Grounded.DiagonalScaleAmount = CalculateDiagonalScaleAmount();
+	Values.DiagonalScaleAmount = CalculateDiagonalScaleAmount(Values.VelocityBlend);
 
 	// Set the Relative Acceleration Amount and Interp the Lean Amount.
-	RelativeAccelerationAmount = CalculateRelativeAccelerationAmount();
-	LeanAmount.LR = FMath::FInterpTo(LeanAmount.LR, RelativeAccelerationAmount.Y, DeltaSeconds,
-	                                 Config.GroundedLeanInterpSpeed);
-	LeanAmount.FB = FMath::FInterpTo(LeanAmount.FB, RelativeAccelerationAmount.X, DeltaSeconds,
-	                                 Config.GroundedLeanInterpSpeed);
+	if (Input.bUpdateLean)
+	{
+		Values.RelativeAccelerationAmount = CalculateRelativeAccelerationAmount(Input);
+		InterpLeanAmount(Values.LeanAmount, Values.RelativeAccelerationAmount.Y, Values.RelativeAccelerationAmount.X,
+		                 DeltaSeconds, Config.GroundedLeanInterpSpeed);
+	}
+	else
+	{
+		Values.RelativeAccelerationAmount = FVector::ZeroVector;
+		Values.LeanAmount = FALSLeanAmount();
+	}
 
 	// Set the Walk Run Blend
-	Grounded.WalkRunBlend = CalculateWalkRunBlend();
+	Values.WalkRunBlend = CalculateWalkRunBlend(Input);
 
 	// Set the Stride Blend
-	Grounded.StrideBlend = CalculateStrideBlend();
+	Values.StrideBlend = CalculateStrideBlend(Input);
 
 	// Set the Standing and Crouching Play Rates
-	Grounded.StandingPlayRate = CalculateStandingPlayRate();
-	Grounded.CrouchingPlayRate = CalculateCrouchingPlayRate();
-}
+	Values.StandingPlayRate = CalculateStandingPlayRate(Input, Values.StrideBlend);
+	Values.CrouchingPlayRate = CalculateCrouchingPlayRate(Input, Values.StrideBlend);
 
-void UALSCharacterAnimInstance::UpdateRotationValues()
-{
 	// Set the Movement Direction
-	MovementDirection = CalculateMovementDirection();
+	Values.MovementDirection = CalculateMovementDirection(Input, Values.MovementDirection);
 
 	// Set the Yaw Offsets. These values influence the "YawOffset" curve in the animgraph and are used to offset
 	// the characters rotation for more natural movement. The curves allow for fine control over how the offset
 	// behaves for each movement direction.
-	FRotator Delta = CharacterInformation.Velocity.ToOrientationRotator() - CharacterInformation.AimingRotation;
+	FRotator Delta = Input.Velocity.ToOrientationRotator() - Input.AimingRotation;
 	Delta.Normalize();
 	const FVector& FBOffset = YawOffset_FB->GetVectorValue(Delta.Yaw);
-	Grounded.FYaw = FBOffset.X;
-	Grounded.BYaw = FBOffset.Y;
+	Values.FYaw = FBOffset.X;
+	Values.BYaw = FBOffset.Y;
 	const FVector& LROffset = YawOffset_LR->GetVectorValue(Delta.Yaw);
-	Grounded.LYaw = LROffset.X;
-	Grounded.RYaw = LROffset.Y;
-}
-
-void UALSCharacterAnimInstance::UpdateInAirValues(float DeltaSeconds)
-{
-	// Update the fall speed. Setting this value only while in the air allows you to use it within the AnimGraph for the landing strength.
-	// If not, the Z velocity would return to 0 on landing.
-	InAir.FallSpeed = CharacterInformation.Velocity.Z;
-
-	// Set the Land Prediction weight.
-	InAir.LandPrediction = CalculateLandPrediction();
-
-	// Interp and set the In Air Lean Amount
-	const FALSLeanAmount& InAirLeanAmount = CalculateAirLeanAmount();
-	LeanAmount.LR = FMath::FInterpTo(LeanAmount.LR, InAirLeanAmount.LR, DeltaSeconds, Config.GroundedLeanInterpSpeed);
-	LeanAmount.FB = FMath::FInterpTo(LeanAmount.FB, InAirLeanAmount.FB, DeltaSeconds, Config.GroundedLeanInterpSpeed);
+	Values.LYaw = LROffset.X;
+	Values.RYaw = LROffset.Y;
 }
 
 void UALSCharacterAnimInstance::UpdateRagdollValues()
 {
 	// Scale the Flail Rate by the velocity length. The faster the ragdoll moves, the faster the character will flail.
-	const float VelocityLength = GetOwningComponent()->GetPhysicsLinearVelocity(NAME__ALSCharacterAnimInstance__root).Size();
-	FlailRate = FMath::GetMappedRangeValueClamped({0.0f, 1000.0f}, {0.0f, 1.0f}, VelocityLength);
+	FlailRate = FMath::GetMappedRangeValueClamped({0.0f, 1000.0f}, {0.0f, 1.0f}, UpdateSnapshot.RagdollSpeed);
 }
 
-float UALSCharacterAnimInstance::GetAnimCurveClamped(const FName& Name, float Bias, float ClampMin,
-                                                     float ClampMax) const
+void UALSCharacterAnimInstance::UpdateCurveValues()
 {
-	return FMath::Clamp(GetCurveValue(Name) + Bias, ClampMin, ClampMax);
+	const FALSAnimLODTier& LODTier = GetCurrentLODTier();
+
+	// Only the curves of the features updating this frame
+	uint32 NeededCurves = FootIKEnableCurves;
+	if (LODTier.bUpdateLayerValues && bReducedRateFrame)
+	{
+		NeededCurves |= LayerValueCurves;
+	}
+	if (LODTier.bUpdateFootIK && bReducedRateFrame)
+	{
+		NeededCurves |= FootLockCurves;
+	}
+	if (MovementState.Grounded())
+	{
+		NeededCurves |= GroundedCurves;
+	}
+	else if (MovementState.InAir() && LODTier.bUpdateLandPrediction)
+	{
+		NeededCurves |= CurveBit(EALSAnimCurve::Mask_LandPrediction);
+	}
+
+	// Read the evaluated curves by UID instead of looking them up by name. The mesh's curves aren't initialized until
+	// its first evaluation, look the curves up by name until then.
+	const FBlendedHeapCurve& AnimCurves = GetOwningComponent()->GetAnimationCurves();
+	const bool bCurvesInitialized = AnimCurves.IsValid();
+	for (int32 Index = 0; Index < static_cast<int32>(EALSAnimCurve::MAX); ++Index)
+	{
+		if (NeededCurves & (1u << Index))
+		{
+			if (!bCurvesInitialized)
+			{
+				CurveValues[Index] = GetCurveValue(NAME_ALSAnimCurves[Index]);
+			}
+			else
+			{
+				CurveValues[Index] = CurveUIDs[Index] != SmartName::MaxUID ? AnimCurves.Get(CurveUIDs[Index]) : 0.0f;
+			}
+		}
+	}
 }
 
-FALSVelocityBlend UALSCharacterAnimInstance::CalculateVelocityBlend() const
+VectorRegister UALSCharacterAnimInstance::CalculateVelocityBlend(const FALSAnimMovementInput& Input)
 {
 	// Calculate the Velocity Blend. This value represents the velocity amount of the actor in each direction (normalized so that
 	// diagonals equal .5 for each direction), and is used in a BlendMulti node to produce better
 	// directional blending than a standard blendspace.
-	const FVector LocRelativeVelocityDir =
-		CharacterInformation.CharacterActorRotation.UnrotateVector(CharacterInformation.Velocity.GetSafeNormal(0.1f));
+	const FVector LocRelativeVelocityDir = Input.ActorQuat.UnrotateVector(Input.Velocity.GetSafeNormal(0.1f));
 	const float Sum = FMath::Abs(LocRelativeVelocityDir.X) + FMath::Abs(LocRelativeVelocityDir.Y) +
 		FMath::Abs(LocRelativeVelocityDir.Z);
 	const FVector RelativeDir = LocRelativeVelocityDir / Sum;
-	FALSVelocityBlend Result;
-	Result.F = FMath::Clamp(RelativeDir.X, 0.0f, 1.0f);
-	Result.B = FMath::Abs(FMath::Clamp(RelativeDir.X, -1.0f, 0.0f));
-	Result.L = FMath::Abs(FMath::Clamp(RelativeDir.Y, -1.0f, 0.0f));
-	Result.R = FMath::Clamp(RelativeDir.Y, 0.0f, 1.0f);
-	return Result;
+
+	// F, B, L, R are the positive X, negative X, negative Y and positive Y parts, clamped to 0..1
+	const VectorRegister Channels = MakeVectorRegister(RelativeDir.X, -RelativeDir.X, -RelativeDir.Y, RelativeDir.Y);
+	return VectorMin(VectorMax(Channels, VectorZero()), VectorOne());
 }
 
-FVector UALSCharacterAnimInstance::CalculateRelativeAccelerationAmount() const
+FVector UALSCharacterAnimInstance::CalculateRelativeAccelerationAmount(const FALSAnimMovementInput& Input)
 {
 	// Calculate the Relative Acceleration Amount. This value represents the current amount of acceleration / deceleration
 	// relative to the actor rotation. It is normalized to a range of -1 to 1 so that -1 equals the Max Braking Deceleration,
 	// and 1 equals the Max Acceleration of the Character Movement Component.
-	if (FVector::DotProduct(CharacterInformation.Acceleration, CharacterInformation.Velocity) > 0.0f)
+	if (FVector::DotProduct(Input.Acceleration, Input.Velocity) > 0.0f)
 	{
-		const float MaxAcc = Character->GetCharacterMovement()->GetMaxAcceleration();
-		return CharacterInformation.CharacterActorRotation.UnrotateVector(
-			CharacterInformation.Acceleration.GetClampedToMaxSize(MaxAcc) / MaxAcc);
+		const float MaxAcc = Input.MaxAcceleration;
+		return Input.ActorQuat.UnrotateVector(Input.Acceleration.GetClampedToMaxSize(MaxAcc) / MaxAcc);
 	}
 
-	const float MaxBrakingDec = Character->GetCharacterMovement()->GetMaxBrakingDeceleration();
-	return
-		CharacterInformation.CharacterActorRotation.UnrotateVector(
-			CharacterInformation.Acceleration.GetClampedToMaxSize(MaxBrakingDec) / MaxBrakingDec);
+	const float MaxBrakingDec = Input.MaxBrakingDeceleration;
+	return Input.ActorQuat.UnrotateVector(Input.Acceleration.GetClampedToMaxSize(MaxBrakingDec) / MaxBrakingDec);
 }
 
-float UALSCharacterAnimInstance::CalculateStrideBlend() const
+float UALSCharacterAnimInstance::CalculateStrideBlend(const FALSAnimMovementInput& Input) const
 {
 	// Calculate the Stride Blend. This value is used within the blendspaces to scale the stride (distance feet travel)
 	// so that the character can walk or run at different movement speeds.
 	// It also allows the walk or run gait animations to blend independently while still matching the animation speed to
 	// the movement speed, preventing the character from needing to play a half walk+half run blend.
 	// The curves are used to map the stride amount to the speed for maximum control.
-	const float CurveTime = CharacterInformation.Speed / GetOwningComponent()->GetComponentScale().Z;
-	const float ClampedGait = GetAnimCurveClamped(NAME_W_Gait, -1.0, 0.0f, 1.0f);
+	const float CurveTime = Input.Speed / Input.MeshScaleZ;
+	const float ClampedGait = FMath::Clamp(Input.GaitCurve - 1.0f, 0.0f, 1.0f);
 	const float LerpedStrideBlend =
 		FMath::Lerp(StrideBlend_N_Walk->GetFloatValue(CurveTime), StrideBlend_N_Run->GetFloatValue(CurveTime),
 		            ClampedGait);
-	return FMath::Lerp(LerpedStrideBlend, StrideBlend_C_Walk->GetFloatValue(CharacterInformation.Speed),
-	                   GetCurveValue(NAME_BasePose_CLF));
+	return FMath::Lerp(LerpedStrideBlend, StrideBlend_C_Walk->GetFloatValue(Input.Speed), Input.BasePoseCLFCurve);
 }
 
-float UALSCharacterAnimInstance::CalculateWalkRunBlend() const
+float UALSCharacterAnimInstance::CalculateWalkRunBlend(const FALSAnimMovementInput& Input)
 {
 	// Calculate the Walk Run Blend. This value is used within the Blendspaces to blend between walking and running.
-	return Gait.Walking() ? 0.0f : 1.0;
+	return Input.Gait == EALSGait::Walking ? 0.0f : 1.0;
 }
 
-float UALSCharacterAnimInstance::CalculateStandingPlayRate() const
+float UALSCharacterAnimInstance::CalculateStandingPlayRate(const FALSAnimMovementInput& Input, float StrideBlend) const
 {
 	// Calculate the Play Rate by dividing the Character's speed by the Animated Speed for each gait.
 	// The lerps are determined by the "W_Gait" anim curve that exists on every locomotion cycle so
 	// that the play rate is always in sync with the currently blended animation.
 	// The value is also divided by the Stride Blend and the mesh scale so that the play rate increases as the stride or scale gets smaller
-	const float LerpedSpeed = FMath::Lerp(CharacterInformation.Speed / Config.AnimatedWalkSpeed,
-	                                      CharacterInformation.Speed / Config.AnimatedRunSpeed,
-	                                      GetAnimCurveClamped(NAME_W_Gait, -1.0f, 0.0f, 1.0f));
+	const float LerpedSpeed = FMath::Lerp(Input.Speed / Config.AnimatedWalkSpeed,
+	                                      Input.Speed / Config.AnimatedRunSpeed,
+	                                      FMath::Clamp(Input.GaitCurve - 1.0f, 0.0f, 1.0f));
 
-	const float SprintAffectedSpeed = FMath::Lerp(LerpedSpeed, CharacterInformation.Speed / Config.AnimatedSprintSpeed,
-	                                              GetAnimCurveClamped(NAME_W_Gait, -2.0f, 0.0f, 1.0f));
+	const float SprintAffectedSpeed = FMath::Lerp(LerpedSpeed, Input.Speed / Config.AnimatedSprintSpeed,
+	                                              FMath::Clamp(Input.GaitCurve - 2.0f, 0.0f, 1.0f));
 
-	return FMath::Clamp((SprintAffectedSpeed / Grounded.StrideBlend) / GetOwningComponent()->GetComponentScale().Z,
-	                    0.0f, 3.0f);
+	return FMath::Clamp((SprintAffectedSpeed / StrideBlend) / Input.MeshScaleZ, 0.0f, 3.0f);
 }
 
-float UALSCharacterAnimInstance::CalculateDiagonalScaleAmount() const
+float UALSCharacterAnimInstance::CalculateDiagonalScaleAmount(const FALSVelocityBlend& CurrentVelocityBlend) const
 {
 	// Calculate the Diagnal Scale Amount. This value is used to scale the Foot IK Root bone to make the Foot IK bones
 	// cover more distance on the diagonal blends. Without scaling, the feet would not move far enough on the diagonal
 	// direction due to the linear translational blending of the IK bones. The curve is used to easily map the value.
-	return DiagonalScaleAmountCurve->GetFloatValue(FMath::Abs(VelocityBlend.F + VelocityBlend.B));
+	return DiagonalScaleAmountCurve->GetFloatValue(FMath::Abs(CurrentVelocityBlend.F + CurrentVelocityBlend.B));
 }
 
-float UALSCharacterAnimInstance::CalculateCrouchingPlayRate() const
+float UALSCharacterAnimInstance::CalculateCrouchingPlayRate(const FALSAnimMovementInput& Input, float StrideBlend) const
 {
 	// Calculate the Crouching Play Rate by dividing the Character's speed by the Animated Speed.
 	// This value needs to be separate from the standing play rate to improve the blend from crocuh to stand while in motion.
-	return FMath::Clamp(
-		CharacterInformation.Speed / Config.AnimatedCrouchSpeed / Grounded.StrideBlend / GetOwningComponent()->
-		GetComponentScale().Z,
-		0.0f, 2.0f);
+	return FMath::Clamp(Input.Speed / Config.AnimatedCrouchSpeed / StrideBlend / Input.MeshScaleZ, 0.0f, 2.0f);
 }
 
-float UALSCharacterAnimInstance::CalculateLandPrediction() const
+float UALSCharacterAnimInstance::CalculateLandPrediction()
 {
 	// Calculate the land prediction weight by tracing in the velocity direction to find a walkable surface the character
 	// is falling toward, and getting the 'Time' (range of 0-1, 1 being maximum, 0 being about to land) till impact.
@@ -794,22 +1292,15 @@ float UALSCharacterAnimInstance::CalculateLandPrediction() const
 	const FVector TraceLength = VelocityClamped * FMath::GetMappedRangeValueClamped(
 		{0.0f, -4000.0f}, {50.0f, 2000.0f}, VelocityZ);
 
-	UWorld* World = GetWorld();
-	check(World);
-
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(Character);
-
 	FHitResult HitResult;
 	const FCollisionShape CapsuleCollisionShape = FCollisionShape::MakeCapsule(CapsuleComp->GetUnscaledCapsuleRadius(),
 	                                                                           CapsuleComp->GetUnscaledCapsuleHalfHeight());
-	const float HalfHeight = 0.0f;
-	const bool bHit = World->SweepSingleByChannel(HitResult, CapsuleWorldLoc, CapsuleWorldLoc + TraceLength, FQuat::Identity,
-	                                              ECC_Visibility, CapsuleCollisionShape, Params);
+	const bool bHit = TraceGround(LandPredictionTraceHandle, CapsuleWorldLoc, CapsuleWorldLoc + TraceLength,
+	                              CapsuleCollisionShape, HitResult);
 
 	if (DebugComponent && DebugComponent->GetShowTraces())
 	{
-		UALSDebugComponent::DrawDebugCapsuleTraceSingle(World,
+		UALSDebugComponent::DrawDebugCapsuleTraceSingle(GetWorld(),
 		                                                CapsuleWorldLoc,
 		                                                CapsuleWorldLoc + TraceLength,
 		                                                CapsuleCollisionShape,
@@ -824,40 +1315,86 @@ float UALSCharacterAnimInstance::CalculateLandPrediction() const
 	if (Character->GetCharacterMovement()->IsWalkable(HitResult))
 	{
 		return FMath::Lerp(LandPredictionCurve->GetFloatValue(HitResult.Time), 0.0f,
-		                   GetCurveValue(NAME_Mask_LandPrediction));
+		                   GetCachedCurveValue(EALSAnimCurve::Mask_LandPrediction));
 	}
 
 	return 0.0f;
 }
 
-FALSLeanAmount UALSCharacterAnimInstance::CalculateAirLeanAmount() const
+bool UALSCharacterAnimInstance::TraceGround(FTraceHandle& TraceHandle, const FVector& Start, const FVector& End,
+                                            const FCollisionShape& Shape, FHitResult& OutHit)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALSAnimGroundTraces);
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSGroundTrace), false, Character);
+
+	// Async results are only kept for one frame, so tiers skipping frames always trace synchronously
+	if (Config.bUseAsyncGroundTraces && GetCurrentLODTier().ReducedRateInterval <= 1)
+	{
+		FTraceDatum TraceDatum;
+		const bool bHasLastResult = TraceHandle.IsValid() && World->QueryTraceData(TraceHandle, TraceDatum);
+
+		INC_DWORD_STAT(STAT_ALSAnimAsyncGroundTraces);
+		TraceHandle = Shape.IsLine()
+			              ? World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_Visibility, Params)
+			              : World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, FQuat::Identity,
+			                                           ECC_Visibility, Shape, Params);
+
+		if (bHasLastResult)
+		{
+			OutHit = TraceDatum.OutHits.Num() > 0 ? TraceDatum.OutHits[0] : FHitResult(1.0f);
+
+			// Move last frame's hit along with the trace, the offset interpolation hides the remaining lag
+			const FVector TraceDelta = Start - TraceDatum.Start;
+			OutHit.Location += TraceDelta;
+			OutHit.ImpactPoint += TraceDelta;
+			OutHit.TraceStart = Start;
+			OutHit.TraceEnd = End;
+			return OutHit.bBlockingHit;
+		}
+	}
+
+	// No result from last frame yet, trace synchronously
+	INC_DWORD_STAT(STAT_ALSAnimSyncGroundTraces);
+	if (Shape.IsLine())
+	{
+		return World->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, Params);
+	}
+	return World->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, ECC_Visibility, Shape, Params);
+}
+
+FALSLeanAmount UALSCharacterAnimInstance::CalculateAirLeanAmount(const FALSAnimMovementInput& Input) const
 {
 	// Use the relative Velocity direction and amount to determine how much the character should lean while in air.
 	// The Lean In Air curve gets the Fall Speed and is used as a multiplier to smoothly reverse the leaning direction
 	// when transitioning from moving upwards to moving downwards.
 	FALSLeanAmount CalcLeanAmount;
-	const FVector& UnrotatedVel = CharacterInformation.CharacterActorRotation.UnrotateVector(
-		CharacterInformation.Velocity) / 350.0f;
+	const FVector& UnrotatedVel = Input.ActorQuat.UnrotateVector(Input.Velocity) / 350.0f;
 	FVector2D InversedVect(UnrotatedVel.Y, UnrotatedVel.X);
-	InversedVect *= LeanInAirCurve->GetFloatValue(InAir.FallSpeed);
+	InversedVect *= LeanInAirCurve->GetFloatValue(Input.FallSpeed);
 	CalcLeanAmount.LR = InversedVect.X;
 	CalcLeanAmount.FB = InversedVect.Y;
 	return CalcLeanAmount;
 }
 
-EALSMovementDirection UALSCharacterAnimInstance::CalculateMovementDirection() const
+EALSMovementDirection UALSCharacterAnimInstance::CalculateMovementDirection(const FALSAnimMovementInput& Input,
+                                                                            EALSMovementDirection CurrentMovementDirection)
 {
 	// Calculate the Movement Direction. This value represents the direction the character is moving relative to the camera
 	// during the Looking Cirection / Aiming rotation modes, and is used in the Cycle Blending Anim Layers to blend to the
 	// appropriate directional states.
-	if (Gait.Sprinting() || RotationMode.VelocityDirection())
+	if (Input.Gait == EALSGait::Sprinting || Input.RotationMode == EALSRotationMode::VelocityDirection)
 	{
 		return EALSMovementDirection::Forward;
 	}
 
-	FRotator Delta = CharacterInformation.Velocity.ToOrientationRotator() - CharacterInformation.AimingRotation;
+	FRotator Delta = Input.Velocity.ToOrientationRotator() - Input.AimingRotation;
 	Delta.Normalize();
-	return UALSMathLibrary::CalculateQuadrant(MovementDirection, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Delta.Yaw);
+	return UALSMathLibrary::CalculateQuadrant(CurrentMovementDirection, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f,
+	                                          Delta.Yaw);
 }
 
 void UALSCharacterAnimInstance::TurnInPlace(FRotator TargetRotation, float PlayRateScale, float StartTime,
@@ -923,8 +1460,9 @@ void UALSCharacterAnimInstance::TurnInPlace(FRotator TargetRotation, float PlayR
 
 void UALSCharacterAnimInstance::OnJumped()
 {
-	InAir.bJumped = true;
-	InAir.JumpPlayRate = FMath::GetMappedRangeValueClamped({0.0f, 600.0f}, {1.2f, 1.5f}, CharacterInformation.Speed);
+	CharacterState.bJumped = true;
+	CharacterState.JumpPlayRate = FMath::GetMappedRangeValueClamped({0.0f, 600.0f}, {1.2f, 1.5f},
+	                                                                CharacterState.CharacterInformation.Speed);
 
 	UWorld* World = GetWorld();
 	check(World);
@@ -9,14 +9,20 @@
 #include "Character/Animation/Notify/ALSAnimNotifyFootstep.h"
 
 #include "Components/AudioComponent.h"
+#include "Containers/StaticArray.h"
 #include "Engine/DataTable.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "NiagaraSystem.h"
+#include "NiagaraComponentPool.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Animation/AnimInstance.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Library/ALSStats.h"
+#include "Sound/SoundBase.h"
+#include "Subsystems/ALSFootstepSubsystem.h"
 
 
 const FName NAME_Mask_FootstepSound(TEXT("Mask_FootstepSound"));
@@ -24,6 +30,113 @@ const FName NAME_Mask_FootstepSound(TEXT("Mask_FootstepSound"));
 FName UALSAnimNotifyFootstep::NAME_FootstepType(TEXT("FootstepType"));
 FName UALSAnimNotifyFootstep::NAME_Foot_R(TEXT("Foot_R"));
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Footstep FX Deferred Loads"), STAT_ALSFootstepDeferredLoads, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Footstep FX Skipped Loads"), STAT_ALSFootstepSkippedLoads, STATGROUP_ALS);
+
+namespace
+{
+	/** Hit FX rows of a single data table, indexed by surface type */
+	struct FALSHitFXSurfaceTable
+	{
+		TStaticArray<FALSHitFX*, SurfaceType_Max> Rows;
+		bool bIsValid = false;
+	};
+
+	/** Shared between all footstep notifies, only accessed from the game thread */
+	TMap<TWeakObjectPtr<const UDataTable>, FALSHitFXSurfaceTable> HitFXSurfaceTables;
+
+	void InvalidateHitFXSurfaceTable(TWeakObjectPtr<const UDataTable> DataTable)
+	{
+		// Row pointers are not stable across table changes, rebuild on next lookup
+		if (FALSHitFXSurfaceTable* SurfaceTable = HitFXSurfaceTables.Find(DataTable))
+		{
+			SurfaceTable->bIsValid = false;
+		}
+	}
+
+	const FALSHitFXSurfaceTable& FindOrBuildHitFXSurfaceTable(UDataTable* DataTable)
+	{
+		check(IsInGameThread());
+
+		FALSHitFXSurfaceTable* FoundSurfaceTable = HitFXSurfaceTables.Find(DataTable);
+		if (FoundSurfaceTable && FoundSurfaceTable->bIsValid)
+		{
+			return *FoundSurfaceTable;
+		}
+
+		if (!FoundSurfaceTable)
+		{
+			// Drop entries of data tables that got garbage collected since the last build
+			for (auto It = HitFXSurfaceTables.CreateIterator(); It; ++It)
+			{
+				if (!It.Key().IsValid())
+				{
+					It.RemoveCurrent();
+				}
+			}
+
+			DataTable->OnDataTableChanged().AddStatic(&InvalidateHitFXSurfaceTable,
+			                                          TWeakObjectPtr<const UDataTable>(DataTable));
+			FoundSurfaceTable = &HitFXSurfaceTables.Add(DataTable);
+		}
+
+		FALSHitFXSurfaceTable& SurfaceTable = *FoundSurfaceTable;
+		SurfaceTable.bIsValid = true;
+		for (FALSHitFX*& Row : SurfaceTable.Rows)
+		{
+			Row = nullptr;
+		}
+
+		TArray<FALSHitFX*> HitFXRows;
+		DataTable->GetAllRows<FALSHitFX>(FString(), HitFXRows);
+
+		// First row of a surface type wins, same as a linear search would
+		for (FALSHitFX* Row : HitFXRows)
+		{
+			FALSHitFX*& SurfaceRow = SurfaceTable.Rows[Row->SurfaceType];
+			if (!SurfaceRow)
+			{
+				SurfaceRow = Row;
+			}
+		}
+
+		// Surfaces without an entry fall back to the default surface
+		FALSHitFX* DefaultRow = SurfaceTable.Rows[SurfaceType_Default];
+		for (FALSHitFX*& Row : SurfaceTable.Rows)
+		{
+			if (!Row)
+			{
+				Row = DefaultRow;
+			}
+		}
+
+		return SurfaceTable;
+	}
+
+	/** Returns the asset if it is resident. Assets still streaming in are skipped instead of blocking the game thread */
+	template <typename T>
+	T* GetHitFXAsset(const TSoftObjectPtr<T>& Asset, bool bAllowSyncLoad)
+	{
+		if (Asset.IsNull())
+		{
+			return nullptr;
+		}
+
+		if (T* LoadedAsset = Asset.Get())
+		{
+			return LoadedAsset;
+		}
+
+		if (bAllowSyncLoad)
+		{
+			return Asset.LoadSynchronous();
+		}
+
+		INC_DWORD_STAT(STAT_ALSFootstepSkippedLoads);
+		return nullptr;
+	}
+}
+
 
 void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation)
 {
@@ -43,130 +156,178 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 		UWorld* World = MeshComp->GetWorld();
 		check(World);
 
+		const AALSBaseCharacter* Character = Cast<AALSBaseCharacter>(MeshOwner);
+		if (Character && Character->ShouldSkipFootstepTraceOnDedicatedServer() && World->GetNetMode() == NM_DedicatedServer)
+		{
+			return;
+		}
+
+		UALSFootstepSubsystem* FootstepSubsystem = World->GetSubsystem<UALSFootstepSubsystem>();
+		if (!FootstepSubsystem)
+		{
+			return;
+		}
+
+		// Nobody would notice the FX of this footstep, skip the trace feeding them as well. Dedicated servers have no
+		// views to cull against, the character's dedicated server setting above decides there.
+		if (World->GetNetMode() != NM_DedicatedServer &&
+			!FootstepSubsystem->IsInFootstepFXRange(MeshOwner->GetActorLocation()))
+		{
+			return;
+		}
+
 		const FVector FootLocation = MeshComp->GetSocketLocation(FootSocketName);
 		const FRotator FootRotation = MeshComp->GetSocketRotation(FootSocketName);
 		const FVector TraceEnd = FootLocation - MeshOwner->GetActorUpVector() * TraceLength;
 
+		// Sample the mask curve now, async trace results are processed after this pose got evaluated
+		float MaskCurveValue = 0.0f;
+		UAnimInstance* AnimInstance = MeshComp->GetAnimInstance();
+		if (bSpawnSound && !bOverrideMaskCurve && AnimInstance)
+		{
+			MaskCurveValue = AnimInstance->GetCurveValue(NAME_Mask_FootstepSound);
+		}
+
+		if (Character && Character->GetFootstepTraceMode() == EALSFootstepTraceMode::Asynchronous)
+		{
+			FootstepSubsystem->QueueFootstepTrace(this, MeshComp, FootLocation, TraceEnd,
+			                                      UEngineTypes::ConvertToCollisionChannel(TraceChannel),
+			                                      FootRotation, MaskCurveValue);
+			return;
+		}
+
 		FHitResult Hit;
 
 		if (UKismetSystemLibrary::LineTraceSingle(MeshOwner /*used by bIgnoreSelf*/, FootLocation, TraceEnd, TraceChannel, true /*bTraceComplex*/, MeshOwner->Children,
 		                                          DrawDebugType, Hit, true /*bIgnoreSelf*/))
 		{
-			if (!Hit.PhysMaterial.Get())
-			{
-				return;
-			}
+			SpawnFootstepFX(MeshComp, Hit, FootRotation, MaskCurveValue);
+		}
+	}
+}
 
-			const EPhysicalSurface SurfaceType = Hit.PhysMaterial.Get()->SurfaceType;
+void UALSAnimNotifyFootstep::SpawnFootstepFX(USkeletalMeshComponent* MeshComp, const FHitResult& Hit,
+                                             const FRotator& FootRotation, float MaskCurveValue) const
+{
+	check(MeshComp);
 
-			check(IsInGameThread());
-			checkNoRecursion();
-			static TArray<FALSHitFX*> HitFXRows;
-			HitFXRows.Reset();
+	AActor* MeshOwner = MeshComp->GetOwner();
+	if (!MeshOwner || !HitDataTable || !Hit.PhysMaterial.Get())
+	{
+		return;
+	}
 
-			HitDataTable->GetAllRows<FALSHitFX>(FString(), HitFXRows);
+	UWorld* World = MeshComp->GetWorld();
+	check(World);
 
-			FALSHitFX* HitFX = nullptr;
-			if (auto FoundResult = HitFXRows.FindByPredicate([&](const FALSHitFX* Value)
-			{
-				return SurfaceType == Value->SurfaceType;
-			}))
-			{
-				HitFX = *FoundResult;
-			}
-			else if (auto DefaultResult = HitFXRows.FindByPredicate([&](const FALSHitFX* Value)
-			{
-				return EPhysicalSurface::SurfaceType_Default == Value->SurfaceType;
-			}))
-			{
-				HitFX = *DefaultResult;
-			}
-			else
-			{
-				return;
-			}
+	// Dedicated servers only trace the footsteps, nobody sees or hears their FX there
+	if (World->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
 
-			if (bSpawnSound && HitFX->Sound.LoadSynchronous())
-			{
-				UAudioComponent* SpawnedSound = nullptr;
+	UALSFootstepSubsystem* FootstepSubsystem = World->GetSubsystem<UALSFootstepSubsystem>();
+	if (!FootstepSubsystem || !FootstepSubsystem->ConsumeFootstepFXBudget())
+	{
+		return;
+	}
 
-				const float MaskCurveValue = MeshComp->GetAnimInstance()->GetCurveValue(
-					NAME_Mask_FootstepSound);
-				const float FinalVolMult = bOverrideMaskCurve
-					                           ? VolumeMultiplier
-					                           : VolumeMultiplier * (1.0f - MaskCurveValue);
+	const EPhysicalSurface SurfaceType = Hit.PhysMaterial.Get()->SurfaceType;
 
-				switch (HitFX->SoundSpawnType)
-				{
-				case EALSSpawnType::Location:
-					SpawnedSound = UGameplayStatics::SpawnSoundAtLocation(
-						World, HitFX->Sound.Get(), Hit.Location + HitFX->SoundLocationOffset,
-						HitFX->SoundRotationOffset, FinalVolMult, PitchMultiplier);
-					break;
-
-				case EALSSpawnType::Attached:
-					SpawnedSound = UGameplayStatics::SpawnSoundAttached(HitFX->Sound.Get(), MeshComp, FootSocketName,
-					                                                    HitFX->SoundLocationOffset,
-					                                                    HitFX->SoundRotationOffset,
-					                                                    HitFX->SoundAttachmentType, true, FinalVolMult,
-					                                                    PitchMultiplier);
-
-					break;
-				}
-				if (SpawnedSound)
-				{
-					SpawnedSound->SetIntParameter(SoundParameterName, static_cast<int32>(FootstepType));
-				}
-			}
+	FALSHitFX* HitFX = FindOrBuildHitFXSurfaceTable(HitDataTable).Rows[SurfaceType];
+	if (!HitFX)
+	{
+		return;
+	}
 
-			if (bSpawnNiagara && HitFX->NiagaraSystem.LoadSynchronous())
-			{
-				UNiagaraComponent* SpawnedParticle = nullptr;
-				const FVector Location = Hit.Location + MeshOwner->GetTransform().TransformVector(
-					HitFX->DecalLocationOffset);
+	// Stream the table in the background if the character didn't preload it, only editor previews load on demand
+	const bool bAllowSyncLoad = !World->IsGameWorld();
+	if (!bAllowSyncLoad && FootstepSubsystem->PreloadHitFX(HitDataTable))
+	{
+		INC_DWORD_STAT(STAT_ALSFootstepDeferredLoads);
+	}
 
-				switch (HitFX->NiagaraSpawnType)
-				{
-				case EALSSpawnType::Location:
-					SpawnedParticle = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
-						World, HitFX->NiagaraSystem.Get(), Location, FootRotation + HitFX->NiagaraRotationOffset);
-					break;
-
-				case EALSSpawnType::Attached:
-					SpawnedParticle = UNiagaraFunctionLibrary::SpawnSystemAttached(
-						HitFX->NiagaraSystem.Get(), MeshComp, FootSocketName, HitFX->NiagaraLocationOffset,
-						HitFX->NiagaraRotationOffset, HitFX->NiagaraAttachmentType, true);
-					break;
-				}
-			}
+	USoundBase* Sound = bSpawnSound ? GetHitFXAsset(HitFX->Sound, bAllowSyncLoad) : nullptr;
+	if (Sound)
+	{
+		UAudioComponent* SpawnedSound = nullptr;
 
-			if (bSpawnDecal && HitFX->DecalMaterial.LoadSynchronous())
-			{
-				const FVector Location = Hit.Location + MeshOwner->GetTransform().TransformVector(
-					HitFX->DecalLocationOffset);
+		const float FinalVolMult = bOverrideMaskCurve
+			                           ? VolumeMultiplier
+			                           : VolumeMultiplier * (1.0f - MaskCurveValue);
 
-				const FVector DecalSize = FVector(bMirrorDecalX ? -HitFX->DecalSize.X : HitFX->DecalSize.X,
-				                                  bMirrorDecalY ? -HitFX->DecalSize.Y : HitFX->DecalSize.Y,
-				                                  bMirrorDecalZ ? -HitFX->DecalSize.Z : HitFX->DecalSize.Z);
+		switch (HitFX->SoundSpawnType)
+		{
+		case EALSSpawnType::Location:
+			SpawnedSound = FootstepSubsystem->PlaySoundAtLocation(
+				Sound, Hit.Location + HitFX->SoundLocationOffset,
+				HitFX->SoundRotationOffset, FinalVolMult, PitchMultiplier);
+			break;
 
-				UDecalComponent* SpawnedDecal = nullptr;
-				switch (HitFX->DecalSpawnType)
-				{
-				case EALSSpawnType::Location:
-					SpawnedDecal = UGameplayStatics::SpawnDecalAtLocation(
-						World, HitFX->DecalMaterial.Get(), DecalSize, Location,
-						FootRotation + HitFX->DecalRotationOffset, HitFX->DecalLifeSpan);
-					break;
-
-				case EALSSpawnType::Attached:
-					SpawnedDecal = UGameplayStatics::SpawnDecalAttached(HitFX->DecalMaterial.Get(), DecalSize,
-					                                                    Hit.Component.Get(), NAME_None, Location,
-					                                                    FootRotation + HitFX->DecalRotationOffset,
-					                                                    HitFX->DecalAttachmentType,
-					                                                    HitFX->DecalLifeSpan);
-					break;
-				}
-			}
+		case EALSSpawnType::Attached:
+			SpawnedSound = FootstepSubsystem->PlaySoundAttached(Sound, MeshComp, FootSocketName,
+			                                                    HitFX->SoundLocationOffset,
+			                                                    HitFX->SoundRotationOffset,
+			                                                    HitFX->SoundAttachmentType, FinalVolMult,
+			                                                    PitchMultiplier);
+
+			break;
+		}
+		if (SpawnedSound)
+		{
+			SpawnedSound->SetIntParameter(SoundParameterName, static_cast<int32>(FootstepType));
+		}
+	}
+
+	UNiagaraSystem* NiagaraSystem = bSpawnNiagara ? GetHitFXAsset(HitFX->NiagaraSystem, bAllowSyncLoad) : nullptr;
+	if (NiagaraSystem)
+	{
+		UNiagaraComponent* SpawnedParticle = nullptr;
+		const FVector Location = Hit.Location + MeshOwner->GetTransform().TransformVector(
+			HitFX->DecalLocationOffset);
+
+		switch (HitFX->NiagaraSpawnType)
+		{
+		case EALSSpawnType::Location:
+			SpawnedParticle = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+				World, NiagaraSystem, Location, FootRotation + HitFX->NiagaraRotationOffset, FVector(1.0f),
+				true, true, ENCPoolMethod::AutoRelease);
+			break;
+
+		case EALSSpawnType::Attached:
+			SpawnedParticle = UNiagaraFunctionLibrary::SpawnSystemAttached(
+				NiagaraSystem, MeshComp, FootSocketName, HitFX->NiagaraLocationOffset,
+				HitFX->NiagaraRotationOffset, HitFX->NiagaraAttachmentType, true, true, ENCPoolMethod::AutoRelease);
+			break;
+		}
+	}
+
+	UMaterialInterface* DecalMaterial = bSpawnDecal ? GetHitFXAsset(HitFX->DecalMaterial, bAllowSyncLoad) : nullptr;
+	if (DecalMaterial)
+	{
+		const FVector Location = Hit.Location + MeshOwner->GetTransform().TransformVector(
+			HitFX->DecalLocationOffset);
+
+		const FVector DecalSize = FVector(bMirrorDecalX ? -HitFX->DecalSize.X : HitFX->DecalSize.X,
+		                                  bMirrorDecalY ? -HitFX->DecalSize.Y : HitFX->DecalSize.Y,
+		                                  bMirrorDecalZ ? -HitFX->DecalSize.Z : HitFX->DecalSize.Z);
+
+		UDecalComponent* SpawnedDecal = nullptr;
+		switch (HitFX->DecalSpawnType)
+		{
+		case EALSSpawnType::Location:
+			SpawnedDecal = FootstepSubsystem->SpawnDecalAtLocation(
+				DecalMaterial, DecalSize, Location,
+				FootRotation + HitFX->DecalRotationOffset, HitFX->DecalLifeSpan);
+			break;
+
+		case EALSSpawnType::Attached:
+			SpawnedDecal = FootstepSubsystem->SpawnDecalAttached(DecalMaterial, DecalSize,
+			                                                     Hit.Component.Get(), Location,
+			                                                     FootRotation + HitFX->DecalRotationOffset,
+			                                                     HitFX->DecalAttachmentType,
+			                                                     HitFX->DecalLifeSpan);
+			break;
 		}
 	}
 }
@@ -173,7 +173,7 @@ void UALSDebugComponent::ToggleDebugView()
 
 	AALSPlayerCameraManager* CamManager = Cast<AALSPlayerCameraManager>(
 		UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0));
-	if (CamManager)
+	if (CamManager && CamManager->CameraBehavior)
 	{
 		UALSPlayerCameraBehavior* CameraBehavior = Cast<UALSPlayerCameraBehavior>(
 			CamManager->CameraBehavior->GetAnimInstance());
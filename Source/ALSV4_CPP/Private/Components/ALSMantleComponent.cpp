@@ -12,24 +12,91 @@
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Components/ALSDebugComponent.h"
 #include "Curves/CurveVector.h"
+#include "Environment/ALSMantleLedgeIndex.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Library/ALSBakedCurve.h"
 #include "Library/ALSMathLibrary.h"
+#include "Library/ALSStats.h"
+#include "Net/UnrealNetwork.h"
+#include "Subsystems/ALSMantleLedgeSubsystem.h"
 
 
-const FName NAME_MantleEnd(TEXT("MantleEnd"));
-const FName NAME_MantleUpdate(TEXT("MantleUpdate"));
-const FName NAME_MantleTimeline(TEXT("MantleTimeline"));
+/** Sample interval of the baked mantle curves */
+const float MantleCurveSampleInterval = 1.0f / 120.0f;
 
 FName UALSMantleComponent::NAME_IgnoreOnlyPawn(TEXT("IgnoreOnlyPawn"));
 
+DECLARE_CYCLE_STAT(TEXT("Mantle Check"), STAT_ALSMantleCheck, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantle Indexed Checks"), STAT_ALSMantleIndexedChecks, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantle Index Misses"), STAT_ALSMantleIndexMisses, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantle Traced Checks"), STAT_ALSMantleTracedChecks, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantle Falling Checks Attempted"), STAT_ALSMantleFallingAttempted, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantle Falling Checks Rejected Early"), STAT_ALSMantleFallingRejected, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantle Falling Checks Succeeded"), STAT_ALSMantleFallingSucceeded, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Mantle Update"), STAT_ALSMantleUpdate, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantle Requests Rejected"), STAT_ALSMantleRequestsRejected, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mantle Requests Corrected"), STAT_ALSMantleRequestsCorrected, STATGROUP_ALS);
+
+/** Same rotation blend as FTransform::Blend */
+static FQuat BlendRotation(const FQuat& A, const FQuat& B, float Alpha)
+{
+	if (Alpha <= ZERO_ANIMWEIGHT_THRESH)
+	{
+		return A;
+	}
+	if (Alpha >= 1.0f - ZERO_ANIMWEIGHT_THRESH)
+	{
+		return B;
+	}
+	return FQuat::FastLerp(A, B, Alpha).GetNormalized();
+}
+
+
+bool FALSReplicatedMantle::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	UObject* ComponentObject = Component;
+	bOutSuccess &= Map->SerializeObject(Ar, UPrimitiveComponent::StaticClass(), ComponentObject);
+
+	// Location with one decimal, compressed rotation
+	bOutSuccess &= SerializePackedVector<10, 24>(LocalLocation, Ar);
+	LocalRotation.SerializeCompressedShort(Ar);
+
+	// Height in millimeters
+	int16 QuantizedHeight = static_cast<int16>(
+		FMath::Clamp(FMath::RoundToInt(MantleHeight * 10.0f), -static_cast<int32>(MAX_int16), static_cast<int32>(MAX_int16)));
+	Ar << QuantizedHeight;
+
+	uint8 Type = static_cast<uint8>(MantleType);
+	Ar.SerializeBits(&Type, 2);
+	Ar << MantleCount;
+
+	if (Ar.IsLoading())
+	{
+		Component = Cast<UPrimitiveComponent>(ComponentObject);
+		MantleHeight = QuantizedHeight / 10.0f;
+		MantleType = static_cast<EALSMantleType>(Type);
+	}
+
+	return true;
+}
 
 UALSMantleComponent::UALSMantleComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = true;
 
-	MantleTimeline = CreateDefaultSubobject<UTimelineComponent>(NAME_MantleTimeline);
+	SetIsReplicatedByDefault(true);
+}
+
+void UALSMantleComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// The owner starts its mantles locally
+	DOREPLIFETIME_CONDITION(UALSMantleComponent, ReplicatedMantle, COND_SkipOwner);
 }
 
 void UALSMantleComponent::BeginPlay()
@@ -44,15 +111,6 @@ void UALSMantleComponent::BeginPlay()
 			AddTickPrerequisiteActor(OwnerCharacter); // Always tick after owner, so we'll use updated values
 
 			// Bindings
-			FOnTimelineFloat TimelineUpdated;
-			FOnTimelineEvent TimelineFinished;
-			TimelineUpdated.BindUFunction(this, NAME_MantleUpdate);
-			TimelineFinished.BindUFunction(this, NAME_MantleEnd);
-			MantleTimeline->SetTimelineFinishedFunc(TimelineFinished);
-			MantleTimeline->SetLooping(false);
-			MantleTimeline->SetTimelineLengthMode(TL_TimelineLength);
-			MantleTimeline->AddInterpFloat(MantleTimelineCurve, TimelineUpdated);
-
 			OwnerCharacter->JumpPressedDelegate.AddUniqueDynamic(this, &UALSMantleComponent::OnOwnerJumpInput);
 			OwnerCharacter->RagdollStateChangedDelegate.AddUniqueDynamic(
 				this, &UALSMantleComponent::OnOwnerRagdollStateChanged);
@@ -68,20 +126,74 @@ void UALSMantleComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (OwnerCharacter && OwnerCharacter->GetMovementState() == EALSMovementState::InAir)
+	if (bMantling)
 	{
-		// Perform a mantle check if falling while movement input is pressed.
-		if (OwnerCharacter->HasMovementInput())
+		UpdateMantlePlayback(DeltaTime);
+		return;
+	}
+
+	if (OwnerCharacter && OwnerCharacter->GetMovementState() == EALSMovementState::InAir &&
+		OwnerCharacter->HasMovementInput())
+	{
+		// Perform a mantle check if falling while movement input is pressed, at most once per check interval.
+		FallingCheckCooldown -= DeltaTime;
+		if (FallingCheckCooldown > 0.0f)
+		{
+			return;
+		}
+
+		INC_DWORD_STAT(STAT_ALSMantleFallingAttempted);
+		if (!CanReachLedge(FallingTraceSettings))
+		{
+			// Nothing can be reached within the prediction window, skip checks until it passes
+			INC_DWORD_STAT(STAT_ALSMantleFallingRejected);
+			FallingCheckCooldown = FallingCheckPredictionTime;
+			return;
+		}
+
+		FallingCheckCooldown = FallingCheckInterval;
+		if (MantleCheck(FallingTraceSettings, EDrawDebugTrace::Type::ForOneFrame))
 		{
-			MantleCheck(FallingTraceSettings, EDrawDebugTrace::Type::ForOneFrame);
+			INC_DWORD_STAT(STAT_ALSMantleFallingSucceeded);
 		}
 	}
+	else
+	{
+		FallingCheckCooldown = 0.0f;
+	}
+}
+
+bool UALSMantleComponent::CanReachLedge(const FALSMantleTraceSettings& TraceSettings) const
+{
+	if (FallingCheckPredictionTime <= 0.0f)
+	{
+		return true;
+	}
+
+	// Overlap the volume the mantle traces can cover during the prediction window, in any direction so that
+	// input changes within the window do not matter. Without blocking geometry in there, no ledge can be found.
+	const FVector CapsuleBaseLocation = UALSMathLibrary::GetCapsuleBaseLocation(
+		2.0f, OwnerCharacter->GetCapsuleComponent());
+	const FVector Displacement = OwnerCharacter->GetVelocity() * FallingCheckPredictionTime +
+		FVector(0.0f, 0.0f, 0.5f * OwnerCharacter->GetCharacterMovement()->GetGravityZ() *
+		        FMath::Square(FallingCheckPredictionTime));
+
+	const float Reach = TraceSettings.ReachDistance + TraceSettings.ForwardTraceRadius;
+	FBox ReachBox(CapsuleBaseLocation + FVector(-Reach, -Reach, TraceSettings.MinLedgeHeight),
+	              CapsuleBaseLocation + FVector(Reach, Reach, TraceSettings.MaxLedgeHeight));
+	ReachBox += ReachBox.ShiftBy(Displacement);
+
+	FCollisionQueryParams Params;
+	Params.AddIgnoredActor(OwnerCharacter);
+	return GetWorld()->OverlapBlockingTestByProfile(ReachBox.GetCenter(), FQuat::Identity,
+	                                                 MantleObjectDetectionProfile,
+	                                                 FCollisionShape::MakeBox(ReachBox.GetExtent()), Params);
 }
 
 void UALSMantleComponent::MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
                                       EALSMantleType MantleType)
 {
-	if (OwnerCharacter == nullptr || !IsValid(MantleLedgeWS.Component) || !IsValid(MantleTimeline))
+	if (OwnerCharacter == nullptr || !IsValid(MantleLedgeWS.Component))
 	{
 		return;
 	}
@@ -91,9 +203,6 @@ void UALSMantleComponent::MantleStart(float MantleHeight, const FALSComponentAnd
 		Cast<AALSCharacter>(OwnerCharacter)->ClearHeldObject();
 	}
 
-	// Disable ticking during mantle
-	SetComponentTickEnabledAsync(false);
-
 	// Step 1: Get the Mantle Asset and use it to set the new Mantle Params.
 	const FALSMantleAsset MantleAsset = GetMantleAsset(MantleType, OwnerCharacter->GetOverlayState());
 	check(MantleAsset.PositionCorrectionCurve)
@@ -128,19 +237,24 @@ void UALSMantleComponent::MantleStart(float MantleHeight, const FALSComponentAnd
 	                             FVector::OneVector);
 	MantleAnimatedStartOffset = UALSMathLibrary::TransfromSub(StartOffset, MantleTarget);
 
+	// Preconvert the offsets to the forms used by MantleUpdate every frame.
+	MantleActualStartRotation = MantleActualStartOffset.Rotator();
+	MantleActualStartQuat = MantleActualStartOffset.GetRotation().GetNormalized();
+	MantleAnimatedStartQuat = MantleAnimatedStartOffset.GetRotation().GetNormalized();
+
 	// Step 5: Clear the Character Movement Mode and set the Movement State to Mantling
 	OwnerCharacter->GetCharacterMovement()->SetMovementMode(MOVE_None);
 	OwnerCharacter->SetMovementState(EALSMovementState::Mantling);
 
-	// Step 6: Configure the Mantle Timeline so that it is the same length as the
+	// Step 6: Configure the mantle playback so that it is the same length as the
 	// Lerp/Correction curve minus the starting position, and plays at the same speed as the animation.
-	// Then start the timeline.
-	float MinTime = 0.0f;
-	float MaxTime = 0.0f;
-	MantleParams.PositionCorrectionCurve->GetTimeRange(MinTime, MaxTime);
-	MantleTimeline->SetTimelineLength(MaxTime - MantleParams.StartingPosition);
-	MantleTimeline->SetPlayRate(MantleParams.PlayRate);
-	MantleTimeline->PlayFromStart();
+	// Then start the playback.
+	PositionCorrectionCurveSamples = FALSBakedCurve::FindOrBake(MantleParams.PositionCorrectionCurve,
+	                                                           MantleCurveSampleInterval);
+	BlendInCurveSamples = FALSBakedCurve::FindOrBake(MantleTimelineCurve, MantleCurveSampleInterval);
+	MantlePlaybackLength = PositionCorrectionCurveSamples->GetMaxTime() - MantleParams.StartingPosition;
+	MantlePlaybackPosition = 0.0f;
+	bMantling = true;
 
 	// Step 7: Play the Anim Montaget if valid.
 	if (IsValid(MantleParams.AnimMontage))
@@ -153,17 +267,93 @@ void UALSMantleComponent::MantleStart(float MantleHeight, const FALSComponentAnd
 
 bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettings, EDrawDebugTrace::Type DebugType)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALSMantleCheck);
+
 	if (!OwnerCharacter)
 	{
 		return false;
 	}
 
-	// Step 1: Trace forward to find a wall / object the character cannot walk on.
 	const FVector& TraceDirection = OwnerCharacter->HasMovementInput()
 		                                ? OwnerCharacter->GetPlayerMovementInput()
 		                                : OwnerCharacter->GetActorForwardVector();
 	const FVector& CapsuleBaseLocation = UALSMathLibrary::GetCapsuleBaseLocation(
 		2.0f, OwnerCharacter->GetCapsuleComponent());
+
+	// Step 1 & 2: Find the ledge in front of the character, in the ledge index if it covers the character's location
+	// and no movable object is within reach. The index holds every other ledge there, so a miss means there is nothing
+	// to mantle. Use the live traces otherwise.
+	FVector DownTraceLocation;
+	FVector InitialTraceNormal;
+	UPrimitiveComponent* HitComponent = nullptr;
+	if (CanUseLedgeIndex(TraceSettings, CapsuleBaseLocation))
+	{
+		INC_DWORD_STAT(STAT_ALSMantleIndexedChecks);
+		if (!FindIndexedLedge(TraceSettings, CapsuleBaseLocation, TraceDirection, DownTraceLocation,
+		                      InitialTraceNormal, HitComponent))
+		{
+			INC_DWORD_STAT(STAT_ALSMantleIndexMisses);
+			return false;
+		}
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ALSMantleTracedChecks);
+		if (!TraceLedge(TraceSettings, CapsuleBaseLocation, TraceDirection, DebugType, DownTraceLocation,
+		                InitialTraceNormal, HitComponent))
+		{
+			return false;
+		}
+	}
+
+	// Step 3: Check if the capsule has room to stand at the downward trace's location.
+	// If so, set that location as the Target Transform and calculate the mantle height.
+	const FVector& CapsuleLocationFBase = UALSMathLibrary::GetCapsuleLocationFromBase(
+		DownTraceLocation, 2.0f, OwnerCharacter->GetCapsuleComponent());
+	const bool bCapsuleHasRoom = UALSMathLibrary::CapsuleHasRoomCheck(OwnerCharacter->GetCapsuleComponent(),
+	                                                                  CapsuleLocationFBase, 0.0f,
+	                                                                  0.0f, DebugType, DebugComponent && DebugComponent->GetShowTraces());
+
+	if (!bCapsuleHasRoom)
+	{
+		// Capsule doesn't have enough room to mantle
+		return false;
+	}
+
+	const FTransform TargetTransform(
+		(InitialTraceNormal * FVector(-1.0f, -1.0f, 0.0f)).ToOrientationRotator(),
+		CapsuleLocationFBase,
+		FVector::OneVector);
+
+	const float MantleHeight = (CapsuleLocationFBase - OwnerCharacter->GetActorLocation()).Z;
+
+	// Step 4: Determine the Mantle Type by checking the movement mode and Mantle Height.
+	EALSMantleType MantleType;
+	if (OwnerCharacter->GetMovementState() == EALSMovementState::InAir)
+	{
+		MantleType = EALSMantleType::FallingCatch;
+	}
+	else
+	{
+		MantleType = MantleHeight > 125.0f ? EALSMantleType::HighMantle : EALSMantleType::LowMantle;
+	}
+
+	// Step 5: If everything checks out, start the Mantle
+	FALSComponentAndTransform MantleWS;
+	MantleWS.Component = HitComponent;
+	MantleWS.Transform = TargetTransform;
+	MantleStart(MantleHeight, MantleWS, MantleType);
+	Server_MantleStart(MantleHeight, MantleWS, MantleType);
+
+	return true;
+}
+
+bool UALSMantleComponent::TraceLedge(const FALSMantleTraceSettings& TraceSettings, const FVector& CapsuleBaseLocation,
+                                     const FVector& TraceDirection, EDrawDebugTrace::Type DebugType,
+                                     FVector& OutLedgeLocation, FVector& OutWallNormal,
+                                     UPrimitiveComponent*& OutComponent)
+{
+	// Step 1: Trace forward to find a wall / object the character cannot walk on.
 	FVector TraceStart = CapsuleBaseLocation + TraceDirection * -30.0f;
 	TraceStart.Z += (TraceSettings.MaxLedgeHeight + TraceSettings.MinLedgeHeight) / 2.0f;
 	const FVector TraceEnd = TraceStart + TraceDirection * TraceSettings.ReachDistance;
@@ -250,48 +440,104 @@ bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettin
 		return false;
 	}
 
-	const FVector DownTraceLocation(HitResult.Location.X, HitResult.Location.Y, HitResult.ImpactPoint.Z);
-	UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+	OutLedgeLocation = FVector(HitResult.Location.X, HitResult.Location.Y, HitResult.ImpactPoint.Z);
+	OutWallNormal = InitialTraceNormal;
+	OutComponent = HitResult.GetComponent();
+	return true;
+}
 
-	// Step 3: Check if the capsule has room to stand at the downward trace's location.
-	// If so, set that location as the Target Transform and calculate the mantle height.
-	const FVector& CapsuleLocationFBase = UALSMathLibrary::GetCapsuleLocationFromBase(
-		DownTraceLocation, 2.0f, OwnerCharacter->GetCapsuleComponent());
-	const bool bCapsuleHasRoom = UALSMathLibrary::CapsuleHasRoomCheck(OwnerCharacter->GetCapsuleComponent(),
-	                                                                  CapsuleLocationFBase, 0.0f,
-	                                                                  0.0f, DebugType, DebugComponent && DebugComponent->GetShowTraces());
+FBox UALSMantleComponent::GetLedgeQueryBox(const FALSMantleTraceSettings& TraceSettings,
+                                           const FVector& CapsuleBaseLocation) const
+{
+	const float Reach = TraceSettings.ReachDistance + TraceSettings.ForwardTraceRadius;
+	return FBox(CapsuleBaseLocation + FVector(-Reach, -Reach, TraceSettings.MinLedgeHeight),
+	            CapsuleBaseLocation + FVector(Reach, Reach, TraceSettings.MaxLedgeHeight));
+}
 
-	if (!bCapsuleHasRoom)
+bool UALSMantleComponent::CanUseLedgeIndex(const FALSMantleTraceSettings& TraceSettings,
+                                           const FVector& CapsuleBaseLocation) const
+{
+	if (!bUseLedgeIndex)
 	{
-		// Capsule doesn't have enough room to mantle
 		return false;
 	}
 
-	const FTransform TargetTransform(
-		(InitialTraceNormal * FVector(-1.0f, -1.0f, 0.0f)).ToOrientationRotator(),
-		CapsuleLocationFBase,
-		FVector::OneVector);
+	UWorld* World = GetWorld();
+	const UALSMantleLedgeSubsystem* LedgeSubsystem = World->GetSubsystem<UALSMantleLedgeSubsystem>();
+	if (!LedgeSubsystem || !LedgeSubsystem->HasLedgeIndices() || !LedgeSubsystem->IsCovered(CapsuleBaseLocation))
+	{
+		return false;
+	}
 
-	const float MantleHeight = (CapsuleLocationFBase - OwnerCharacter->GetActorLocation()).Z;
+	// Movable objects are not indexed, use the live traces if any mantleable one is within reach, whatever its
+	// object type
+	FCollisionQueryParams Params;
+	Params.AddIgnoredActor(OwnerCharacter);
+	TArray<FOverlapResult> Overlaps;
+	const FBox QueryBox = GetLedgeQueryBox(TraceSettings, CapsuleBaseLocation);
+	World->OverlapMultiByProfile(Overlaps, QueryBox.GetCenter(), FQuat::Identity, MantleObjectDetectionProfile,
+	                             FCollisionShape::MakeBox(QueryBox.GetExtent()), Params);
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		const UPrimitiveComponent* Component = Overlap.GetComponent();
+		if (Overlap.bBlockingHit && Component && Component->Mobility == EComponentMobility::Movable)
+		{
+			return false;
+		}
+	}
 
-	// Step 4: Determine the Mantle Type by checking the movement mode and Mantle Height.
-	EALSMantleType MantleType;
-	if (OwnerCharacter->GetMovementState() == EALSMovementState::InAir)
+	return true;
+}
+
+bool UALSMantleComponent::FindIndexedLedge(const FALSMantleTraceSettings& TraceSettings,
+                                           const FVector& CapsuleBaseLocation, const FVector& TraceDirection,
+                                           FVector& OutLedgeLocation, FVector& OutWallNormal,
+                                           UPrimitiveComponent*& OutComponent) const
+{
+	const UALSMantleLedgeSubsystem* LedgeSubsystem = GetWorld()->GetSubsystem<UALSMantleLedgeSubsystem>();
+	const FVector Direction = TraceDirection.GetSafeNormal2D();
+	if (!LedgeSubsystem || Direction.IsNearlyZero())
 	{
-		MantleType = EALSMantleType::FallingCatch;
+		return false;
 	}
-	else
+
+	// Only allocates when there are ledges within reach
+	TArray<const FALSMantleLedge*> Ledges;
+	LedgeSubsystem->GetLedgesInBox(GetLedgeQueryBox(TraceSettings, CapsuleBaseLocation), Ledges);
+
+	// Pick the closest ledge the forward trace would have hit: in front of the character within reach,
+	// inside the forward trace radius and facing the character.
+	const FALSMantleLedge* ClosestLedge = nullptr;
+	float ClosestDistance = TNumericLimits<float>::Max();
+	for (const FALSMantleLedge* Ledge : Ledges)
 	{
-		MantleType = MantleHeight > 125.0f ? EALSMantleType::HighMantle : EALSMantleType::LowMantle;
+		// Ledges of unloaded levels are skipped
+		if (!IsValid(Ledge->Component.Get()) || FVector::DotProduct(Ledge->WallNormal, Direction) > -0.5f)
+		{
+			continue;
+		}
+
+		const FVector Offset = (Ledge->Location - CapsuleBaseLocation) * FVector(1.0f, 1.0f, 0.0f);
+		const float Distance = FVector::DotProduct(Offset, Direction);
+		const float LateralDistance = (Offset - Direction * Distance).Size();
+		if (Distance < -30.0f || Distance > TraceSettings.ReachDistance + TraceSettings.ForwardTraceRadius ||
+			LateralDistance > TraceSettings.ForwardTraceRadius || Distance >= ClosestDistance)
+		{
+			continue;
+		}
+
+		ClosestLedge = Ledge;
+		ClosestDistance = Distance;
 	}
 
-	// Step 5: If everything checks out, start the Mantle
-	FALSComponentAndTransform MantleWS;
-	MantleWS.Component = HitComponent;
-	MantleWS.Transform = TargetTransform;
-	MantleStart(MantleHeight, MantleWS, MantleType);
-	Server_MantleStart(MantleHeight, MantleWS, MantleType);
+	if (!ClosestLedge)
+	{
+		return false;
+	}
 
+	OutLedgeLocation = ClosestLedge->Location;
+	OutWallNormal = ClosestLedge->WallNormal;
+	OutComponent = ClosestLedge->Component.Get();
 	return true;
 }
 
@@ -299,34 +545,209 @@ void UALSMantleComponent::Server_MantleStart_Implementation(float MantleHeight,
                                                             const FALSComponentAndTransform& MantleLedgeWS,
                                                             EALSMantleType MantleType)
 {
-	Multicast_MantleStart(MantleHeight, MantleLedgeWS, MantleType);
+	if (!OwnerCharacter || !IsValid(MantleLedgeWS.Component))
+	{
+		return;
+	}
+
+	if (!OwnerCharacter->IsLocallyControlled())
+	{
+		// Requests of remote clients are validated, and corrected where the server knows better
+		if (!ValidateMantleRequest(MantleHeight, MantleLedgeWS, MantleType))
+		{
+			INC_DWORD_STAT(STAT_ALSMantleRequestsRejected);
+			Client_RejectMantle();
+			return;
+		}
+
+		MantleStart(MantleHeight, MantleLedgeWS, MantleType);
+	}
+
+	// Replicate the mantle to the other clients that the character is relevant to
+	const FTransform LocalTransform = MantleLedgeWS.Transform.GetRelativeTransform(
+		MantleLedgeWS.Component->GetComponentTransform());
+	ReplicatedMantle.Component = MantleLedgeWS.Component;
+	ReplicatedMantle.LocalLocation = LocalTransform.GetLocation();
+	ReplicatedMantle.LocalRotation = LocalTransform.Rotator();
+	ReplicatedMantle.MantleHeight = MantleHeight;
+	ReplicatedMantle.MantleType = MantleType;
+	++ReplicatedMantle.MantleCount;
+
+	if (GetOwner())
+	{
+		GetOwner()->ForceNetUpdate();
+	}
 }
 
-void UALSMantleComponent::Multicast_MantleStart_Implementation(float MantleHeight,
-                                                               const FALSComponentAndTransform& MantleLedgeWS,
-                                                               EALSMantleType MantleType)
+bool UALSMantleComponent::ValidateMantleRequest(float& MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
+                                                EALSMantleType& MantleType)
 {
-	if (OwnerCharacter && !OwnerCharacter->IsLocallyControlled())
+	// Step 1: Rate limit the requests, and ignore them while a mantle is still playing.
+	const float WorldTime = GetWorld()->GetTimeSeconds();
+	if (bMantling || WorldTime - LastMantleRequestTime < MinMantleRequestInterval ||
+		OwnerCharacter->GetMovementState() == EALSMovementState::Ragdoll)
 	{
-		MantleStart(MantleHeight, MantleLedgeWS, MantleType);
+		return false;
+	}
+
+	// Step 2: The ledge component has to be something the mantle check could have found.
+	UPrimitiveComponent* LedgeComponent = MantleLedgeWS.Component;
+	if (!LedgeComponent->IsCollisionEnabled() ||
+		LedgeComponent->GetCollisionResponseToChannel(WalkableSurfaceDetectionChannel) != ECR_Block ||
+		LedgeComponent->GetComponentVelocity().Size() > AcceptableVelocityWhileMantling)
+	{
+		return false;
+	}
+
+	// Step 3: The target has to be within reach of the capsule.
+	const FVector TargetOffset = MantleLedgeWS.Transform.GetLocation() - OwnerCharacter->GetActorLocation();
+	const float MaxReach = FMath::Max3(GroundedTraceSettings.ReachDistance, AutomaticTraceSettings.ReachDistance,
+	                                   FallingTraceSettings.ReachDistance) +
+		FMath::Max3(GroundedTraceSettings.ForwardTraceRadius, AutomaticTraceSettings.ForwardTraceRadius,
+		            FallingTraceSettings.ForwardTraceRadius);
+	if (TargetOffset.Size2D() > MaxReach + MantleRequestTolerance)
+	{
+		return false;
+	}
+
+	// Step 4: The target has to stand on the ledge component, a walkable surface right below the capsule's base.
+	FVector LedgeLocation = MantleLedgeWS.Transform.GetLocation();
+	LedgeLocation.Z -= OwnerCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + 2.0f;
+	FHitResult LedgeHit;
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSValidateMantleLedge), true);
+	if (!LedgeComponent->LineTraceComponent(LedgeHit, LedgeLocation + FVector(0.0f, 0.0f, MantleRequestTolerance),
+	                                        LedgeLocation - FVector(0.0f, 0.0f, MantleRequestTolerance), Params) ||
+		!OwnerCharacter->GetCharacterMovement()->IsWalkable(LedgeHit))
+	{
+		return false;
+	}
+
+	// Step 5: Use the height and type the server sees. Small differences are corrected, big ones rejected.
+	const float ServerMantleHeight = TargetOffset.Z;
+	if (FMath::Abs(ServerMantleHeight - MantleHeight) > MantleRequestTolerance)
+	{
+		return false;
+	}
+
+	// Falling catches are only accepted while the server sees the character in the air
+	EALSMantleType ServerMantleType = MantleType;
+	if (MantleType == EALSMantleType::FallingCatch)
+	{
+		if (OwnerCharacter->GetMovementState() != EALSMovementState::InAir)
+		{
+			return false;
+		}
+	}
+	else
+	{
+		ServerMantleType = ServerMantleHeight > 125.0f ? EALSMantleType::HighMantle : EALSMantleType::LowMantle;
+	}
+
+	// Step 6: The height has to be within the band of the mantle asset.
+	const FALSMantleAsset MantleAsset = GetMantleAsset(ServerMantleType, OwnerCharacter->GetOverlayState());
+	if (ServerMantleHeight < MantleAsset.LowHeight - MantleRequestTolerance ||
+		ServerMantleHeight > MantleAsset.HighHeight + MantleRequestTolerance)
+	{
+		return false;
+	}
+
+	// Step 7: The capsule has to have room to stand at the target, same as the mantle check, and the way up from
+	// the capsule and over to the target can't be blocked by a ceiling or a wall.
+	const FVector TargetLocation = MantleLedgeWS.Transform.GetLocation();
+	if (!UALSMathLibrary::CapsuleHasRoomCheck(OwnerCharacter->GetCapsuleComponent(), TargetLocation, 0.0f, 0.0f))
+	{
+		return false;
+	}
+
+	const FVector ActorLocation = OwnerCharacter->GetActorLocation();
+	const FVector AboveActorLocation(ActorLocation.X, ActorLocation.Y, FMath::Max(ActorLocation.Z, TargetLocation.Z));
+	FCollisionQueryParams PathParams(SCENE_QUERY_STAT(ALSValidateMantlePath), false, OwnerCharacter);
+	if (GetWorld()->LineTraceTestByChannel(ActorLocation, AboveActorLocation, WalkableSurfaceDetectionChannel,
+	                                       PathParams) ||
+		GetWorld()->LineTraceTestByChannel(AboveActorLocation, TargetLocation, WalkableSurfaceDetectionChannel,
+		                                   PathParams))
+	{
+		return false;
+	}
+
+	if (ServerMantleType != MantleType || !FMath::IsNearlyEqual(ServerMantleHeight, MantleHeight, 1.0f))
+	{
+		INC_DWORD_STAT(STAT_ALSMantleRequestsCorrected);
+	}
+
+	// Only accepted requests count towards the rate limit, so a rejected one doesn't block the next valid one
+	LastMantleRequestTime = WorldTime;
+	MantleHeight = ServerMantleHeight;
+	MantleType = ServerMantleType;
+	return true;
+}
+
+void UALSMantleComponent::Client_RejectMantle_Implementation()
+{
+	if (!bMantling || !OwnerCharacter)
+	{
+		return;
+	}
+
+	// Stop the mantle, the server will correct the character's location
+	bMantling = false;
+	if (IsValid(MantleParams.AnimMontage) && OwnerCharacter->GetMainAnimInstance())
+	{
+		OwnerCharacter->GetMainAnimInstance()->Montage_Stop(0.2f, MantleParams.AnimMontage);
+	}
+	OwnerCharacter->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+}
+
+void UALSMantleComponent::OnRep_ReplicatedMantle()
+{
+	// Values received with the initial replication are mantles that started before the character became relevant
+	if (!HasBegunPlay() || !IsValid(ReplicatedMantle.Component))
+	{
+		return;
+	}
+
+	FALSComponentAndTransform MantleLedgeWS;
+	MantleLedgeWS.Component = ReplicatedMantle.Component;
+	MantleLedgeWS.Transform = FTransform(ReplicatedMantle.LocalRotation, ReplicatedMantle.LocalLocation) *
+		ReplicatedMantle.Component->GetComponentTransform();
+	MantleStart(ReplicatedMantle.MantleHeight, MantleLedgeWS, ReplicatedMantle.MantleType);
+}
+
+void UALSMantleComponent::UpdateMantlePlayback(float DeltaTime)
+{
+	MantlePlaybackPosition = FMath::Min(MantlePlaybackPosition + DeltaTime * MantleParams.PlayRate,
+	                                    MantlePlaybackLength);
+
+	const float BlendIn = BlendInCurveSamples.IsValid() && BlendInCurveSamples->IsBaked()
+		                      ? BlendInCurveSamples->EvaluateFloat(MantlePlaybackPosition)
+		                      : 1.0f;
+	MantleUpdate(BlendIn);
+
+	if (MantlePlaybackPosition >= MantlePlaybackLength)
+	{
+		MantleEnd();
 	}
 }
 
-// This function is called by "MantleTimeline" using BindUFunction in the AALSBaseCharacter::BeginPlay during the default settings initalization.
 void UALSMantleComponent::MantleUpdate(float BlendIn)
 {
-	if (!OwnerCharacter)
+	SCOPE_CYCLE_COUNTER(STAT_ALSMantleUpdate);
+
+	if (!OwnerCharacter || !IsValid(MantleLedgeLS.Component) || !PositionCorrectionCurveSamples.IsValid())
 	{
 		return;
 	}
 
 	// Step 1: Continually update the mantle target from the stored local transform to follow along with moving objects
-	MantleTarget = UALSMathLibrary::MantleComponentLocalToWorld(MantleLedgeLS);
+	const FTransform& LedgeComponentTransform = MantleLedgeLS.Component->GetComponentTransform();
+	MantleTarget.SetLocation(LedgeComponentTransform.TransformPosition(MantleLedgeLS.Transform.GetLocation()));
+	MantleTarget.SetRotation(LedgeComponentTransform.TransformRotation(MantleLedgeLS.Transform.GetRotation()));
+	const FVector TargetLocation = MantleTarget.GetLocation();
+	const FRotator TargetRotation = MantleTarget.Rotator();
 
 	// Step 2: Update the Position and Correction Alphas using the Position/Correction curve set for each Mantle.
-	const FVector CurveVec = MantleParams.PositionCorrectionCurve
-	                                     ->GetVectorValue(
-		                                     MantleParams.StartingPosition + MantleTimeline->GetPlaybackPosition());
+	const FVector CurveVec = PositionCorrectionCurveSamples->EvaluateVector(
+		MantleParams.StartingPosition + MantlePlaybackPosition);
 	const float PositionAlpha = CurveVec.X;
 	const float XYCorrectionAlpha = CurveVec.Y;
 	const float ZCorrectionAlpha = CurveVec.Z;
@@ -334,53 +755,33 @@ void UALSMantleComponent::MantleUpdate(float BlendIn)
 	// Step 3: Lerp multiple transforms together for independent control over the horizontal
 	// and vertical blend to the animated start position, as well as the target position.
 
-	// Blend into the animated horizontal and rotation offset using the Y value of the Position/Correction Curve.
-	const FTransform TargetHzTransform(MantleAnimatedStartOffset.GetRotation(),
-	                                   {
-		                                   MantleAnimatedStartOffset.GetLocation().X,
-		                                   MantleAnimatedStartOffset.GetLocation().Y,
-		                                   MantleActualStartOffset.GetLocation().Z
-	                                   },
-	                                   FVector::OneVector);
-	const FTransform& HzLerpResult =
-		UKismetMathLibrary::TLerp(MantleActualStartOffset, TargetHzTransform, XYCorrectionAlpha);
-
-	// Blend into the animated vertical offset using the Z value of the Position/Correction Curve.
-	const FTransform TargetVtTransform(MantleActualStartOffset.GetRotation(),
-	                                   {
-		                                   MantleActualStartOffset.GetLocation().X,
-		                                   MantleActualStartOffset.GetLocation().Y,
-		                                   MantleAnimatedStartOffset.GetLocation().Z
-	                                   },
-	                                   FVector::OneVector);
-	const FTransform& VtLerpResult =
-		UKismetMathLibrary::TLerp(MantleActualStartOffset, TargetVtTransform, ZCorrectionAlpha);
-
-	const FTransform ResultTransform(HzLerpResult.GetRotation(),
-	                                 {
-		                                 HzLerpResult.GetLocation().X, HzLerpResult.GetLocation().Y,
-		                                 VtLerpResult.GetLocation().Z
-	                                 },
-	                                 FVector::OneVector);
+	// Blend into the animated horizontal and rotation offset using the Y value of the Position/Correction Curve,
+	// and into the animated vertical offset using the Z value.
+	const FVector ActualStartLocation = MantleActualStartOffset.GetLocation();
+	const FVector ResultLocation = ActualStartLocation + (MantleAnimatedStartOffset.GetLocation() - ActualStartLocation) *
+		FVector(XYCorrectionAlpha, XYCorrectionAlpha, ZCorrectionAlpha);
+	const FQuat ResultRotation = BlendRotation(MantleActualStartQuat, MantleAnimatedStartQuat, XYCorrectionAlpha);
 
 	// Blend from the currently blending transforms into the final mantle target using the X
 	// value of the Position/Correction Curve.
-	const FTransform& ResultLerp = UKismetMathLibrary::TLerp(
-		UALSMathLibrary::TransfromAdd(MantleTarget, ResultTransform), MantleTarget,
-		PositionAlpha);
+	const FVector ResultLerpLocation = FMath::Lerp(TargetLocation + ResultLocation, TargetLocation, PositionAlpha);
+	const FQuat ResultLerpRotation = BlendRotation(FQuat(TargetRotation + ResultRotation.Rotator()),
+	                                               MantleTarget.GetRotation(), PositionAlpha);
 
 	// Initial Blend In (controlled in the timeline curve) to allow the actor to blend into the Position/Correction
 	// curve at the midoint. This prevents pops when mantling an object lower than the animated mantle.
-	const FTransform& LerpedTarget =
-		UKismetMathLibrary::TLerp(UALSMathLibrary::TransfromAdd(MantleTarget, MantleActualStartOffset), ResultLerp,
-		                          BlendIn);
+	const FVector LerpedLocation = FMath::Lerp(TargetLocation + ActualStartLocation, ResultLerpLocation, BlendIn);
+	const FQuat LerpedRotation = BlendRotation(FQuat(TargetRotation + MantleActualStartRotation), ResultLerpRotation,
+	                                           BlendIn);
 
 	// Step 4: Set the actors location and rotation to the Lerped Target.
-	OwnerCharacter->SetActorLocationAndTargetRotation(LerpedTarget.GetLocation(), LerpedTarget.GetRotation().Rotator());
+	OwnerCharacter->SetActorLocationAndTargetRotation(LerpedLocation, LerpedRotation.Rotator());
 }
 
 void UALSMantleComponent::MantleEnd()
 {
+	bMantling = false;
+
 	// Set the Character Movement Mode to Walking
 	if (OwnerCharacter)
 	{
@@ -391,9 +792,6 @@ void UALSMantleComponent::MantleEnd()
 			Cast<AALSCharacter>(OwnerCharacter)->UpdateHeldObject();
 		}
 	}
-
-	// Enable ticking back after mantle ends
-	SetComponentTickEnabledAsync(true);
 }
 
 void UALSMantleComponent::OnOwnerJumpInput()
@@ -421,6 +819,6 @@ void UALSMantleComponent::OnOwnerRagdollStateChanged(bool bRagdollState)
 	// If owner is going into ragdoll state, stop mantling immediately
 	if (bRagdollState)
 	{
-		MantleTimeline->Stop();
+		bMantling = false;
 	}
 }
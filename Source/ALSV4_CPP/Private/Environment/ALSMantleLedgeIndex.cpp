@@ -0,0 +1,297 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Environment/ALSMantleLedgeIndex.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Components/SceneComponent.h"
+#include "EngineUtils.h"
+#include "Subsystems/ALSMantleLedgeSubsystem.h"
+
+
+const FName NAME_LedgeIndexRoot(TEXT("Root"));
+
+AALSMantleLedgeIndex::AALSMantleLedgeIndex()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetActorHiddenInGame(true);
+	SetCanBeDamaged(false);
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(NAME_LedgeIndexRoot);
+
+	TraceSettings.MaxLedgeHeight = 250.0f;
+	TraceSettings.MinLedgeHeight = 50.0f;
+	TraceSettings.ReachDistance = 75.0f;
+	TraceSettings.ForwardTraceRadius = 30.0f;
+	TraceSettings.DownwardTraceRadius = 30.0f;
+}
+
+void AALSMantleLedgeIndex::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UALSMantleLedgeSubsystem* LedgeSubsystem = GetWorld()->GetSubsystem<UALSMantleLedgeSubsystem>())
+	{
+		LedgeSubsystem->RegisterLedgeIndex(this);
+	}
+}
+
+void AALSMantleLedgeIndex::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UALSMantleLedgeSubsystem* LedgeSubsystem = GetWorld()->GetSubsystem<UALSMantleLedgeSubsystem>())
+	{
+		LedgeSubsystem->UnregisterLedgeIndex(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+int64 AALSMantleLedgeIndex::GetCellKey(const FIntVector& Cell) const
+{
+	// 21 bits per axis
+	return (static_cast<int64>(Cell.X & 0x1FFFFF) << 42) | (static_cast<int64>(Cell.Y & 0x1FFFFF) << 21) |
+		static_cast<int64>(Cell.Z & 0x1FFFFF);
+}
+
+FIntVector AALSMantleLedgeIndex::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize),
+	                  FMath::FloorToInt(Location.Y / CellSize),
+	                  FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void AALSMantleLedgeIndex::GetLedgesInBox(const FBox& Box, TArray<const FALSMantleLedge*>& OutLedges) const
+{
+	if (!Bounds.IsValid || !Bounds.Intersect(Box))
+	{
+		return;
+	}
+
+	const FIntVector MinCell = GetCell(Box.Min);
+	const FIntVector MaxCell = GetCell(Box.Max);
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const FALSMantleLedgeCell* Cell = Cells.Find(GetCellKey(FIntVector(X, Y, Z)));
+				if (!Cell)
+				{
+					continue;
+				}
+
+				for (int32 Index = Cell->FirstLedge; Index < Cell->FirstLedge + Cell->NumLedges; ++Index)
+				{
+					if (Box.IsInsideOrOn(Ledges[Index].Location))
+					{
+						OutLedges.Add(&Ledges[Index]);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool AALSMantleLedgeIndex::IsIndexedComponent(const UPrimitiveComponent* Component) const
+{
+	// Only static and stationary geometry, movable objects are handled by the live traces
+	return Component->Mobility != EComponentMobility::Movable && Component->IsCollisionEnabled() &&
+		Component->GetCollisionResponseToChannel(WalkableSurfaceDetectionChannel) == ECR_Block;
+}
+
+void AALSMantleLedgeIndex::BuildLedgeIndex()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	Modify();
+	Ledges.Reset();
+	Cells.Reset();
+	Bounds.Init();
+
+	// Step 1: The covered area is the geometry of this level, reachable from below and from the side
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (It->GetLevel() != GetLevel() || *It == this)
+		{
+			continue;
+		}
+
+		TInlineComponentArray<UPrimitiveComponent*> Components(*It);
+		for (const UPrimitiveComponent* Component : Components)
+		{
+			if (IsIndexedComponent(Component))
+			{
+				Bounds += Component->Bounds.GetBox();
+			}
+		}
+	}
+
+	if (!Bounds.IsValid)
+	{
+		return;
+	}
+
+	const float Reach = TraceSettings.ReachDistance + TraceSettings.ForwardTraceRadius;
+	Bounds = Bounds.ExpandBy(FVector(Reach, Reach, TraceSettings.MaxLedgeHeight));
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSBuildLedgeIndex), false, this);
+	const FCollisionShape DownwardShape = FCollisionShape::MakeSphere(TraceSettings.DownwardTraceRadius);
+	const FCollisionShape RoomShape = FCollisionShape::MakeCapsule(ReferenceCapsuleRadius, ReferenceCapsuleHalfHeight);
+	const float WallTraceHeight = FMath::Max(TraceSettings.MinLedgeHeight * 0.5f, 1.0f);
+	const float EdgeDirectionStep = 360.0f / NumEdgeDirections;
+
+	// Ledges closer than half the sample spacing with the same facing are merged
+	TSet<TTuple<FIntVector, int32>> OccupiedLedges;
+	const float MergeDistance = SampleSpacing * 0.5f;
+	TArray<FVector, TInlineAllocator<32>> EdgeDirections;
+
+	// Step 2: Scan the geometry of every loaded level within the covered area, so that IsCovered never reports an
+	// area whose geometry wasn't scanned
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (*It == this)
+		{
+			continue;
+		}
+
+		TInlineComponentArray<UPrimitiveComponent*> Components(*It);
+		for (UPrimitiveComponent* Component : Components)
+		{
+			const FBox ComponentBounds = Component->Bounds.GetBox();
+			if (!IsIndexedComponent(Component) || !Bounds.Intersect(ComponentBounds))
+			{
+				continue;
+			}
+
+			// Probe around the sample in every direction so that rotated, curved and landscape edges are found
+			const FVector ComponentForward = Component->GetForwardVector().GetSafeNormal2D();
+			EdgeDirections.Reset();
+			for (int32 Index = 0; Index < NumEdgeDirections; ++Index)
+			{
+				EdgeDirections.Add((ComponentForward.IsNearlyZero() ? FVector::ForwardVector : ComponentForward)
+					.RotateAngleAxis(Index * EdgeDirectionStep, FVector::UpVector));
+			}
+
+			for (float X = ComponentBounds.Min.X; X <= ComponentBounds.Max.X; X += SampleSpacing)
+			{
+				for (float Y = ComponentBounds.Min.Y; Y <= ComponentBounds.Max.Y; Y += SampleSpacing)
+				{
+					// Step 3: Find a walkable point on top of the component.
+					FHitResult TopHit;
+					if (!Component->LineTraceComponent(TopHit, FVector(X, Y, ComponentBounds.Max.Z + 1.0f),
+					                                   FVector(X, Y, ComponentBounds.Min.Z - 1.0f), Params) ||
+						TopHit.ImpactNormal.Z < WalkableFloorZ)
+					{
+						continue;
+					}
+
+					for (const FVector& EdgeDirection : EdgeDirections)
+					{
+						// Step 4: The ground past the edge must be lower than the minimum ledge height.
+						const FVector EdgeProbe = TopHit.ImpactPoint + EdgeDirection * SampleSpacing;
+						FHitResult GroundHit;
+						if (World->LineTraceSingleByChannel(GroundHit, EdgeProbe + FVector(0.0f, 0.0f, 1.0f),
+						                                    EdgeProbe - FVector(0.0f, 0.0f, TraceSettings.MinLedgeHeight),
+						                                    WalkableSurfaceDetectionChannel, Params))
+						{
+							continue;
+						}
+
+						// Step 5: Trace back towards the edge to find the wall / object the character cannot walk on.
+						FVector WallTraceStart = EdgeProbe + EdgeDirection * TraceSettings.ForwardTraceRadius;
+						WallTraceStart.Z -= WallTraceHeight;
+						FVector WallTraceEnd = TopHit.ImpactPoint - EdgeDirection * SampleSpacing;
+						WallTraceEnd.Z -= WallTraceHeight;
+						FHitResult WallHit;
+						if (!World->LineTraceSingleByProfile(WallHit, WallTraceStart, WallTraceEnd,
+						                                     MantleObjectDetectionProfile, Params) ||
+							WallHit.ImpactNormal.Z >= WalkableFloorZ || WallHit.bStartPenetrating)
+						{
+							continue;
+						}
+
+						const FVector WallNormal = WallHit.ImpactNormal.GetSafeNormal2D();
+						if (WallNormal.IsNearlyZero())
+						{
+							continue;
+						}
+
+						// Step 6: Trace downward from the wall like the mantle check and determine if the hit
+						// location is walkable.
+						const FVector DownwardTraceEnd = WallHit.ImpactPoint + WallNormal * -15.0f;
+						FVector DownwardTraceStart = DownwardTraceEnd;
+						DownwardTraceStart.Z = TopHit.ImpactPoint.Z + TraceSettings.DownwardTraceRadius + 1.0f;
+						FHitResult DownwardHit;
+						if (!World->SweepSingleByChannel(DownwardHit, DownwardTraceStart, DownwardTraceEnd,
+						                                 FQuat::Identity, WalkableSurfaceDetectionChannel, DownwardShape,
+						                                 Params) ||
+							DownwardHit.ImpactNormal.Z < WalkableFloorZ || DownwardHit.bStartPenetrating)
+						{
+							continue;
+						}
+
+						UPrimitiveComponent* LedgeComponent = DownwardHit.GetComponent();
+						if (!LedgeComponent || LedgeComponent->Mobility == EComponentMobility::Movable)
+						{
+							continue;
+						}
+
+						FALSMantleLedge Ledge;
+						Ledge.Location = FVector(DownwardHit.Location.X, DownwardHit.Location.Y,
+						                         DownwardHit.ImpactPoint.Z);
+						Ledge.WallNormal = WallNormal;
+						Ledge.Component = LedgeComponent;
+
+						const TTuple<FIntVector, int32> LedgeKey(
+							FIntVector(FMath::FloorToInt(Ledge.Location.X / MergeDistance),
+							           FMath::FloorToInt(Ledge.Location.Y / MergeDistance),
+							           FMath::FloorToInt(Ledge.Location.Z / MergeDistance)),
+							FMath::RoundToInt(FMath::RadiansToDegrees(WallNormal.HeadingAngle()) / 45.0f));
+						if (OccupiedLedges.Contains(LedgeKey))
+						{
+							continue;
+						}
+
+						// Step 7: Check if the reference capsule has room to stand on the ledge.
+						const FVector RoomLocation = Ledge.Location + FVector(0.0f, 0.0f,
+						                                                      ReferenceCapsuleHalfHeight + 2.0f);
+						if (World->OverlapBlockingTestByChannel(RoomLocation, FQuat::Identity,
+						                                        WalkableSurfaceDetectionChannel, RoomShape, Params))
+						{
+							continue;
+						}
+
+						OccupiedLedges.Add(LedgeKey);
+						Ledges.Add(Ledge);
+					}
+				}
+			}
+		}
+	}
+
+	// Sort the ledges by cell so every cell references a contiguous range
+	Ledges.Sort([this](const FALSMantleLedge& A, const FALSMantleLedge& B)
+	{
+		return GetCellKey(GetCell(A.Location)) < GetCellKey(GetCell(B.Location));
+	});
+
+	for (int32 Index = 0; Index < Ledges.Num(); ++Index)
+	{
+		FALSMantleLedgeCell& Cell = Cells.FindOrAdd(GetCellKey(GetCell(Ledges[Index].Location)));
+		if (Cell.NumLedges == 0)
+		{
+			Cell.FirstLedge = Index;
+		}
+		++Cell.NumLedges;
+	}
+}
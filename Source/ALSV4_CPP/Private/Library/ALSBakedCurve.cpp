@@ -0,0 +1,172 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Library/ALSBakedCurve.h"
+
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+
+
+namespace
+{
+	struct FALSBakedCurveEntry
+	{
+		TSharedPtr<FALSBakedCurve> BakedCurve;
+		float SampleInterval = 0.0f;
+	};
+
+	/** Bakes of each curve, one per sample interval. Shared between all users, only accessed from the game thread */
+	TMap<TWeakObjectPtr<const UCurveBase>, TArray<FALSBakedCurveEntry, TInlineAllocator<1>>> BakedCurves;
+
+	void BakeCurve(const UCurveBase* Curve, float SampleInterval, FALSBakedCurve& BakedCurve)
+	{
+		if (const UCurveVector* VectorCurve = Cast<UCurveVector>(Curve))
+		{
+			BakedCurve.Bake(VectorCurve, SampleInterval);
+		}
+		else if (const UCurveFloat* FloatCurve = Cast<UCurveFloat>(Curve))
+		{
+			BakedCurve.Bake(FloatCurve, SampleInterval);
+		}
+	}
+
+#if WITH_EDITOR
+	void RebakeCurve(const UObject* Curve)
+	{
+		// Bake in place, so that users holding the baked curve pick up the edit as well
+		if (const auto* Entries = BakedCurves.Find(Cast<UCurveBase>(Curve)))
+		{
+			for (const FALSBakedCurveEntry& Entry : *Entries)
+			{
+				BakeCurve(CastChecked<UCurveBase>(Curve), Entry.SampleInterval, *Entry.BakedCurve);
+			}
+		}
+	}
+
+	void OnCurveUpdated(UCurveBase* Curve, EPropertyChangeType::Type ChangeType)
+	{
+		RebakeCurve(Curve);
+	}
+
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+	{
+		RebakeCurve(Object);
+	}
+#endif
+}
+
+void FALSBakedCurve::SetTimeRange(float InMinTime, float InMaxTime, float SampleInterval)
+{
+	MinTime = InMinTime;
+	MaxTime = FMath::Max(InMinTime, InMaxTime);
+
+	// Spread the samples evenly over the whole range, the last one lands exactly on the last key
+	const int32 NumIntervals = FMath::Max(FMath::CeilToInt((MaxTime - MinTime) / FMath::Max(SampleInterval, KINDA_SMALL_NUMBER)), 1);
+	SamplesPerSecond = MaxTime > MinTime ? NumIntervals / (MaxTime - MinTime) : 0.0f;
+	Samples.SetNumUninitialized(NumIntervals + 1);
+}
+
+void FALSBakedCurve::Bake(const UCurveFloat* Curve, float SampleInterval)
+{
+	Samples.Reset();
+	if (!Curve)
+	{
+		return;
+	}
+
+	float CurveMinTime = 0.0f;
+	float CurveMaxTime = 0.0f;
+	Curve->GetTimeRange(CurveMinTime, CurveMaxTime);
+	SetTimeRange(CurveMinTime, CurveMaxTime, SampleInterval);
+
+	const float Step = Samples.Num() > 1 ? (MaxTime - MinTime) / (Samples.Num() - 1) : 0.0f;
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		Samples[Index] = FVector(Curve->GetFloatValue(MinTime + Step * Index), 0.0f, 0.0f);
+	}
+}
+
+void FALSBakedCurve::Bake(const UCurveVector* Curve, float SampleInterval)
+{
+	Samples.Reset();
+	if (!Curve)
+	{
+		return;
+	}
+
+	float CurveMinTime = 0.0f;
+	float CurveMaxTime = 0.0f;
+	Curve->GetTimeRange(CurveMinTime, CurveMaxTime);
+	SetTimeRange(CurveMinTime, CurveMaxTime, SampleInterval);
+
+	const float Step = Samples.Num() > 1 ? (MaxTime - MinTime) / (Samples.Num() - 1) : 0.0f;
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		Samples[Index] = Curve->GetVectorValue(MinTime + Step * Index);
+	}
+}
+
+FVector FALSBakedCurve::EvaluateVector(float Time) const
+{
+	if (Samples.Num() == 0)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const float Position = FMath::Clamp(Time - MinTime, 0.0f, MaxTime - MinTime) * SamplesPerSecond;
+	const int32 Index = FMath::Min(FMath::FloorToInt(Position), Samples.Num() - 1);
+	const int32 NextIndex = FMath::Min(Index + 1, Samples.Num() - 1);
+	return FMath::Lerp(Samples[Index], Samples[NextIndex], Position - Index);
+}
+
+TSharedPtr<const FALSBakedCurve> FALSBakedCurve::FindOrBake(const UCurveBase* Curve, float SampleInterval)
+{
+	check(IsInGameThread());
+
+	if (!Curve)
+	{
+		return nullptr;
+	}
+
+	if (const auto* Entries = BakedCurves.Find(Curve))
+	{
+		for (const FALSBakedCurveEntry& Entry : *Entries)
+		{
+			if (Entry.SampleInterval == SampleInterval)
+			{
+				return Entry.BakedCurve;
+			}
+		}
+	}
+	else
+	{
+		// Drop the curves that were unloaded since the last bake
+		for (auto It = BakedCurves.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+#if WITH_EDITOR
+		// Curve editor edits only broadcast OnUpdateCurve, details panel edits, undo and reimports go through
+		// PostEditChange
+		UCurveBase* MutableCurve = const_cast<UCurveBase*>(Curve);
+		MutableCurve->OnUpdateCurve.AddStatic(&OnCurveUpdated);
+		static const FDelegateHandle ObjectPropertyChangedHandle =
+			FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&OnObjectPropertyChanged);
+#endif
+	}
+
+	FALSBakedCurveEntry& Entry = BakedCurves.FindOrAdd(Curve).AddDefaulted_GetRef();
+	Entry.BakedCurve = MakeShared<FALSBakedCurve>();
+	Entry.SampleInterval = SampleInterval;
+	BakeCurve(Curve, SampleInterval, *Entry.BakedCurve);
+	return Entry.BakedCurve;
+}
@@ -13,6 +13,7 @@
 #include "Components/ALSDebugComponent.h"
 
 #include "Components/CapsuleComponent.h"
+#include "GameFramework/PlayerController.h"
 
 FTransform UALSMathLibrary::MantleComponentLocalToWorld(const FALSComponentAndTransform& CompAndTransform)
 {
@@ -34,6 +35,32 @@ TPair<float, float> UALSMathLibrary::FixDiagonalGamepadValues(const float X, con
 	return TPair<float, float>(ResultY, ResultX);
 }
 
+float UALSMathLibrary::GetClosestViewDistance(const UWorld* World, const FVector& Location)
+{
+	float ClosestDistanceSquared = MAX_flt;
+	for (const FVector& ViewLocation : World->ViewLocationsRenderedLastFrame)
+	{
+		ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(ViewLocation, Location));
+	}
+
+	if (World->ViewLocationsRenderedLastFrame.Num() == 0)
+	{
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PlayerController = It->Get();
+			if (PlayerController)
+			{
+				FVector ViewLocation;
+				FRotator ViewRotation;
+				PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(ViewLocation, Location));
+			}
+		}
+	}
+
+	return FMath::Sqrt(ClosestDistanceSquared);
+}
+
 FVector UALSMathLibrary::GetCapsuleBaseLocation(const float ZOffset, UCapsuleComponent* Capsule)
 {
 	return Capsule->GetComponentLocation() -
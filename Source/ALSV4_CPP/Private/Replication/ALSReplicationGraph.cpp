@@ -0,0 +1,328 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Replication/ALSReplicationGraph.h"
+
+#include "Character/ALSBaseCharacter.h"
+#include "Engine/ChildConnection.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "Library/ALSStats.h"
+#include "UObject/UObjectIterator.h"
+
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rep Graph Characters"), STAT_ALSRepGraphCharacters, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rep Graph Dependent Actors"), STAT_ALSRepGraphDependentActors, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rep Graph Owner Only Actors"), STAT_ALSRepGraphOwnerOnlyActors, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Rep Graph Locomotion Tiers"), STAT_ALSRepGraphLocomotionTiers, STATGROUP_ALS);
+
+void UALSReplicationGraphNode_LocomotionTiers::GatherActorListsForConnection(
+	const FConnectionGatherActorListParameters& Params)
+{
+	if (Params.ReplicationFrameNum % UpdatePeriodFrame != 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ALSRepGraphLocomotionTiers);
+
+	// Only the characters in the grid cells around the connection's viewers, characters the connection doesn't
+	// consider keep their last period until they are gathered again. Characters never replicate faster than their
+	// class settings, the tier interval only lowers the rate.
+	UNetConnection* Connection = Params.ConnectionManager.NetConnection;
+	for (const FActorRepListConstView& List : Params.OutGatheredReplicationLists.GetLists(EActorRepListTypeFlags::Default))
+	{
+		for (FActorRepListType Actor : List)
+		{
+			const AALSBaseCharacter* Character = Cast<AALSBaseCharacter>(Actor);
+			if (!Character)
+			{
+				continue;
+			}
+
+			const FALSLocomotionReplicationTier* Tier = Character->FindLocomotionReplicationTier(Connection);
+			const uint32 TierPeriodFrame = Tier && !Tier->bDropLocomotionData
+				                               ? static_cast<uint32>(FMath::CeilToInt(
+					                               Tier->UpdateInterval * ServerMaxTickRate))
+				                               : 0;
+			const FGlobalActorReplicationInfo& GlobalInfo = GraphGlobals->GlobalActorReplicationInfoMap->Get(Actor);
+			FConnectionReplicationActorInfo& ActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(Actor);
+			ActorInfo.ReplicationPeriodFrame = FMath::Max<uint32>(GlobalInfo.Settings.ReplicationPeriodFrame,
+			                                                      TierPeriodFrame);
+		}
+	}
+}
+
+void UALSReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Every loaded character class gets the settings of its own defaults, classes loaded later get them when their
+	// first instance is added
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if (Class->IsChildOf(AALSBaseCharacter::StaticClass()) &&
+			!Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists) &&
+			!Class->GetName().StartsWith(TEXT("SKEL_")) && !Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			InitCharacterClassInfo(Class);
+		}
+	}
+}
+
+void UALSReplicationGraph::InitCharacterClassInfo(UClass* Class)
+{
+	const AALSBaseCharacter* CharacterCDO = CastChecked<AALSBaseCharacter>(Class->GetDefaultObject());
+	const float MaxTickRate = NetDriver ? static_cast<float>(NetDriver->NetServerMaxTickRate) : 30.0f;
+
+	FClassReplicationInfo CharacterClassInfo;
+	CharacterClassInfo.DistancePriorityScale = CharacterDistancePriorityScale;
+	CharacterClassInfo.StarvationPriorityScale = 1.0f;
+	CharacterClassInfo.ActorChannelFrameTimeout = 4;
+	CharacterClassInfo.ReplicationPeriodFrame = FMath::Max<uint32>(
+		static_cast<uint32>(FMath::RoundToFloat(MaxTickRate / CharacterCDO->NetUpdateFrequency)), 1);
+	CharacterClassInfo.SetCullDistanceSquared(FMath::Square(CharacterCullDistance));
+	GlobalActorReplicationInfoMap.SetClassInfo(Class, CharacterClassInfo);
+	CharacterClasses.Add(Class);
+}
+
+void UALSReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = SpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UALSReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	// The controller, pawn and view target of the connection, so owned characters are never culled for their owner,
+	// and the owner only actors of the connection
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantForConnectionNode =
+		CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantForConnectionNode, RepGraphConnection);
+	AlwaysRelevantForConnectionNodes.Add(RepGraphConnection->NetConnection, AlwaysRelevantForConnectionNode);
+
+	UALSReplicationGraphNode_LocomotionTiers* LocomotionTiersNode =
+		CreateNewNode<UALSReplicationGraphNode_LocomotionTiers>();
+	LocomotionTiersNode->ServerMaxTickRate = NetDriver ? static_cast<float>(NetDriver->NetServerMaxTickRate) : 30.0f;
+	LocomotionTiersNode->UpdatePeriodFrame = FMath::Max(LocomotionTierUpdatePeriodFrame, 1);
+	AddConnectionGraphNode(LocomotionTiersNode, RepGraphConnection);
+
+	// Owner only actors added before their connection was
+	for (TPair<AActor*, UNetConnection*>& OwnerOnlyActor : OwnerOnlyActorConnections)
+	{
+		if (!OwnerOnlyActor.Value && GetOwningConnection(OwnerOnlyActor.Key) == RepGraphConnection->NetConnection)
+		{
+			OwnerOnlyActor.Value = RepGraphConnection->NetConnection;
+			AlwaysRelevantForConnectionNode->NotifyAddNetworkActor(FNewReplicatedActorInfo(OwnerOnlyActor.Key));
+		}
+	}
+}
+
+void UALSReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	AlwaysRelevantForConnectionNodes.Remove(NetConnection);
+	for (TPair<AActor*, UNetConnection*>& OwnerOnlyActor : OwnerOnlyActorConnections)
+	{
+		if (OwnerOnlyActor.Value == NetConnection)
+		{
+			OwnerOnlyActor.Value = nullptr;
+		}
+	}
+
+	Super::RemoveClientConnection(NetConnection);
+}
+
+int32 UALSReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	RouteChangedOwners();
+	return Super::ServerReplicateActors(DeltaSeconds);
+}
+
+void UALSReplicationGraph::RouteChangedOwners()
+{
+	TArray<AActor*, TInlineAllocator<16>> ChangedActors;
+	for (const TPair<AActor*, TWeakObjectPtr<AALSBaseCharacter>>& DependentActor : DependentActorOwners)
+	{
+		if (DependentActor.Value.Get() != GetOwningCharacter(DependentActor.Key))
+		{
+			ChangedActors.Add(DependentActor.Key);
+		}
+	}
+	for (const TPair<AActor*, UNetConnection*>& OwnerOnlyActor : OwnerOnlyActorConnections)
+	{
+		if (OwnerOnlyActor.Value != GetOwningConnection(OwnerOnlyActor.Key))
+		{
+			ChangedActors.Add(OwnerOnlyActor.Key);
+		}
+	}
+
+	for (AActor* Actor : ChangedActors)
+	{
+		const FNewReplicatedActorInfo ActorInfo(Actor);
+		RouteRemoveNetworkActorToNodes(ActorInfo);
+		RouteAddNetworkActorToNodes(ActorInfo, GlobalActorReplicationInfoMap.Get(Actor));
+	}
+}
+
+void UALSReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo,
+                                                       FGlobalActorReplicationInfo& GlobalInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+
+	// Owner only actors never become dependents, they would replicate to every connection the owner reaches
+	if (Actor->bOnlyRelevantToOwner)
+	{
+		// Player controllers are gathered by the always relevant node of their connection on their own
+		if (!Actor->IsA<APlayerController>())
+		{
+			UNetConnection* Connection = GetOwningConnection(Actor);
+			UReplicationGraphNode_AlwaysRelevant_ForConnection** ConnectionNode =
+				AlwaysRelevantForConnectionNodes.Find(Connection);
+			if (ConnectionNode)
+			{
+				(*ConnectionNode)->NotifyAddNetworkActor(ActorInfo);
+			}
+			OwnerOnlyActorConnections.Add(Actor, ConnectionNode ? Connection : nullptr);
+			INC_DWORD_STAT(STAT_ALSRepGraphOwnerOnlyActors);
+		}
+		return;
+	}
+
+	// Held objects and other actors owned by a character replicate whenever the character does
+	if (AALSBaseCharacter* OwningCharacter = GetOwningCharacter(Actor))
+	{
+		GlobalActorReplicationInfoMap.AddDependentActor(OwningCharacter, Actor);
+		DependentActorOwners.Add(Actor, OwningCharacter);
+		INC_DWORD_STAT(STAT_ALSRepGraphDependentActors);
+		return;
+	}
+
+	if (Actor->bAlwaysRelevant || !Actor->GetRootComponent())
+	{
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		return;
+	}
+
+	if (Actor->IsA<AALSBaseCharacter>())
+	{
+		if (!CharacterClasses.Contains(Actor->GetClass()))
+		{
+			InitCharacterClassInfo(Actor->GetClass());
+			GlobalInfo.Settings = GlobalActorReplicationInfoMap.GetClassInfo(Actor->GetClass());
+		}
+
+		INC_DWORD_STAT(STAT_ALSRepGraphCharacters);
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+	}
+	else if (Actor->NetDormancy != DORM_Awake)
+	{
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+	}
+	else if (Actor->IsRootComponentMovable())
+	{
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+	}
+	else
+	{
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+	}
+}
+
+void UALSReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+
+	// Removed from where they were added, their owner may have changed since
+	TWeakObjectPtr<AALSBaseCharacter> RegisteredCharacter;
+	if (DependentActorOwners.RemoveAndCopyValue(Actor, RegisteredCharacter))
+	{
+		if (AALSBaseCharacter* OwningCharacter = RegisteredCharacter.Get())
+		{
+			GlobalActorReplicationInfoMap.RemoveDependentActor(OwningCharacter, Actor);
+		}
+		DEC_DWORD_STAT(STAT_ALSRepGraphDependentActors);
+		return;
+	}
+
+	UNetConnection* RegisteredConnection = nullptr;
+	if (OwnerOnlyActorConnections.RemoveAndCopyValue(Actor, RegisteredConnection))
+	{
+		if (UReplicationGraphNode_AlwaysRelevant_ForConnection** ConnectionNode =
+			AlwaysRelevantForConnectionNodes.Find(RegisteredConnection))
+		{
+			(*ConnectionNode)->NotifyRemoveNetworkActor(ActorInfo);
+		}
+		DEC_DWORD_STAT(STAT_ALSRepGraphOwnerOnlyActors);
+		return;
+	}
+
+	if (Actor->bOnlyRelevantToOwner)
+	{
+		return;
+	}
+
+	if (Actor->bAlwaysRelevant || !Actor->GetRootComponent())
+	{
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		return;
+	}
+
+	if (Actor->IsA<AALSBaseCharacter>())
+	{
+		DEC_DWORD_STAT(STAT_ALSRepGraphCharacters);
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+	}
+	else if (Actor->NetDormancy != DORM_Awake)
+	{
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+	}
+	else if (Actor->IsRootComponentMovable())
+	{
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+	}
+	else
+	{
+		GridNode->RemoveActor_Static(ActorInfo);
+	}
+}
+
+AALSBaseCharacter* UALSReplicationGraph::GetOwningCharacter(const AActor* Actor)
+{
+	if (Actor->IsA<AALSBaseCharacter>())
+	{
+		return nullptr;
+	}
+
+	for (AActor* Owner = Actor->GetOwner(); Owner; Owner = Owner->GetOwner())
+	{
+		if (AALSBaseCharacter* OwningCharacter = Cast<AALSBaseCharacter>(Owner))
+		{
+			return OwningCharacter;
+		}
+	}
+	return nullptr;
+}
+
+UNetConnection* UALSReplicationGraph::GetOwningConnection(const AActor* Actor)
+{
+	UNetConnection* Connection = Actor->GetNetConnection();
+	if (const UChildConnection* ChildConnection = Cast<UChildConnection>(Connection))
+	{
+		return ChildConnection->Parent;
+	}
+	return Connection;
+}
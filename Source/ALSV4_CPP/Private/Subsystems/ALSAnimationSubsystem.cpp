@@ -0,0 +1,183 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Subsystems/ALSAnimationSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Library/ALSStats.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Anim Batch Update"), STAT_ALSAnimBatchUpdate, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Batch Compute"), STAT_ALSAnimBatchCompute, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Anim Batch Instances"), STAT_ALSAnimBatchInstances, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Batch Computed Instances"), STAT_ALSAnimBatchComputedInstances, STATGROUP_ALS);
+
+void FALSAnimationTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                            const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Subsystem->UpdateMovementValues(DeltaTime);
+	}
+}
+
+FString FALSAnimationTickFunction::DiagnosticMessage()
+{
+	return TEXT("UALSAnimationSubsystem::UpdateMovementValues");
+}
+
+void UALSAnimationSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	while (AnimInstances.Num() > 0)
+	{
+		RemoveAnimInstanceAt(AnimInstances.Num() - 1);
+	}
+
+	Super::Deinitialize();
+}
+
+void UALSAnimationSubsystem::RegisterAnimInstance(UALSCharacterAnimInstance* AnimInstance)
+{
+	if (!AnimInstance || !AnimInstance->Character || AnimInstances.Contains(AnimInstance))
+	{
+		return;
+	}
+
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.Subsystem = this;
+		TickFunction.TickGroup = TG_PrePhysics;
+		TickFunction.bCanEverTick = true;
+		TickFunction.bStartWithTickEnabled = true;
+		TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	// The batch reads the character after its movement and tick, the skeletal mesh uses the values in its tick
+	AALSBaseCharacter* Character = AnimInstance->Character;
+	TickFunction.AddPrerequisite(Character, Character->PrimaryActorTick);
+	if (UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement())
+	{
+		TickFunction.AddPrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+	}
+	AnimInstance->GetOwningComponent()->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
+
+	AnimInstances.Add(AnimInstance);
+	INC_DWORD_STAT(STAT_ALSAnimBatchInstances);
+}
+
+void UALSAnimationSubsystem::UnregisterAnimInstance(UALSCharacterAnimInstance* AnimInstance)
+{
+	const int32 Index = AnimInstances.IndexOfByKey(AnimInstance);
+	if (Index != INDEX_NONE)
+	{
+		RemoveAnimInstanceAt(Index);
+	}
+}
+
+void UALSAnimationSubsystem::RemoveAnimInstanceAt(int32 Index)
+{
+	if (UALSCharacterAnimInstance* AnimInstance = AnimInstances[Index].Get())
+	{
+		if (AALSBaseCharacter* Character = AnimInstance->Character)
+		{
+			TickFunction.RemovePrerequisite(Character, Character->PrimaryActorTick);
+			if (UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement())
+			{
+				TickFunction.RemovePrerequisite(CharacterMovement, CharacterMovement->PrimaryComponentTick);
+			}
+		}
+		if (USkeletalMeshComponent* Mesh = AnimInstance->GetOwningComponent())
+		{
+			Mesh->PrimaryComponentTick.RemovePrerequisite(this, TickFunction);
+		}
+	}
+
+	AnimInstances.RemoveAtSwap(Index);
+	DEC_DWORD_STAT(STAT_ALSAnimBatchInstances);
+}
+
+bool UALSAnimationSubsystem::IsUpdatingEveryFrame(const USkeletalMeshComponent* Mesh)
+{
+	// Tick intervals include the ones set by the significance subsystem
+	if (!Mesh || !Mesh->IsComponentTickEnabled() || Mesh->GetComponentTickInterval() > 0.0f || !Mesh->ShouldTickPose())
+	{
+		return false;
+	}
+
+	// Update rate optimizations skip frames
+	return !Mesh->bEnableUpdateRateOptimizations || !Mesh->AnimUpdateRateParams ||
+		Mesh->AnimUpdateRateParams->UpdateRate <= 1;
+}
+
+void UALSAnimationSubsystem::UpdateMovementValues(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALSAnimBatchUpdate);
+
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	// Step 1: Gather the inputs and current values on the game thread
+	BatchedInstances.Reset();
+	Inputs.Reset();
+	Values.Reset();
+	for (int32 Index = AnimInstances.Num() - 1; Index >= 0; --Index)
+	{
+		UALSCharacterAnimInstance* AnimInstance = AnimInstances[Index].Get();
+		if (!AnimInstance || !AnimInstance->Character)
+		{
+			RemoveAnimInstanceAt(Index);
+			continue;
+		}
+
+		// Meshes that skip or accumulate frames update on their own, with the delta time of their own tick
+		if (!IsUpdatingEveryFrame(AnimInstance->GetOwningComponent()))
+		{
+			continue;
+		}
+
+		// Gathered once per frame, the anim instance proxy's PreUpdate reuses it
+		const float InstanceDeltaTime = DeltaTime * AnimInstance->Character->CustomTimeDilation;
+		AnimInstance->GatherCharacterInformation(InstanceDeltaTime);
+		FALSAnimMovementInput Input;
+		if (!AnimInstance->GatherMovementInput(InstanceDeltaTime, Input))
+		{
+			continue;
+		}
+
+		BatchedInstances.Add(AnimInstance);
+		Inputs.Add(Input);
+		AnimInstance->GatherMovementValues(Values.AddDefaulted_GetRef());
+	}
+
+	INC_DWORD_STAT_BY(STAT_ALSAnimBatchComputedInstances, BatchedInstances.Num());
+
+	// Step 2: Compute the movement values, same as UALSCharacterAnimInstance::UpdateMovementValues
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ALSAnimBatchCompute);
+		ParallelFor(BatchedInstances.Num(), [this](int32 Index)
+		{
+			BatchedInstances[Index]->CalculateMovementValues(Inputs[Index], Values[Index]);
+		}, BatchedInstances.Num() < MinParallelBatchSize);
+	}
+
+	// Step 3: Write the results back on the game thread
+	for (int32 Index = 0; Index < BatchedInstances.Num(); ++Index)
+	{
+		BatchedInstances[Index]->ApplyBatchedMovementValues(Values[Index]);
+	}
+}
@@ -0,0 +1,386 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Subsystems/ALSFootstepSubsystem.h"
+
+#include "Character/Animation/Notify/ALSAnimNotifyFootstep.h"
+#include "Components/AudioComponent.h"
+#include "Components/DecalComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/DataTable.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Kismet/GameplayStatics.h"
+#include "KismetTraceUtils.h"
+#include "Library/ALSCharacterStructLibrary.h"
+#include "Library/ALSStats.h"
+
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Async Traces"), STAT_ALSFootstepAsyncTraces, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep FX Culled By Distance"), STAT_ALSFootstepCulledByDistance, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep FX Culled By Budget"), STAT_ALSFootstepCulledByBudget, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Sounds Dropped"), STAT_ALSFootstepSoundsDropped, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Decals Reused"), STAT_ALSFootstepDecalsReused, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Footstep Pooled Audio Components"), STAT_ALSFootstepPooledAudioComponents, STATGROUP_ALS);
+
+namespace
+{
+	UAudioComponent* PlayPooledSound(UAudioComponent* AudioComponent, USoundBase* Sound, float VolumeMultiplier,
+	                                 float PitchMultiplier)
+	{
+		AudioComponent->SetSound(Sound);
+		AudioComponent->SetVolumeMultiplier(VolumeMultiplier);
+		AudioComponent->SetPitchMultiplier(PitchMultiplier);
+		AudioComponent->Play();
+		return AudioComponent;
+	}
+}
+
+void UALSFootstepSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FootstepTraceDelegate.BindUObject(this, &UALSFootstepSubsystem::OnFootstepTraceCompleted);
+}
+
+void UALSFootstepSubsystem::Deinitialize()
+{
+	PendingFootsteps.Empty();
+	DEC_DWORD_STAT_BY(STAT_ALSFootstepPooledAudioComponents, AudioComponentPool.Num());
+	AudioComponentPool.Empty();
+	DecalRing.Empty();
+
+	for (const auto& Pair : HitFXPreloadHandles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->CancelHandle();
+		}
+	}
+	HitFXPreloadHandles.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UALSFootstepSubsystem::PreloadHitFX(UDataTable* HitDataTable)
+{
+	if (!HitDataTable || HitFXPreloadHandles.Contains(HitDataTable))
+	{
+		return false;
+	}
+
+	TArray<FALSHitFX*> HitFXRows;
+	HitDataTable->GetAllRows<FALSHitFX>(FString(), HitFXRows);
+
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const FALSHitFX* HitFX : HitFXRows)
+	{
+		if (!HitFX->Sound.IsNull())
+		{
+			AssetsToLoad.AddUnique(HitFX->Sound.ToSoftObjectPath());
+		}
+		if (!HitFX->DecalMaterial.IsNull())
+		{
+			AssetsToLoad.AddUnique(HitFX->DecalMaterial.ToSoftObjectPath());
+		}
+		if (!HitFX->NiagaraSystem.IsNull())
+		{
+			AssetsToLoad.AddUnique(HitFX->NiagaraSystem.ToSoftObjectPath());
+		}
+	}
+
+	// Tables without any assets still get an entry, so they are not scanned again
+	TSharedPtr<FStreamableHandle> Handle;
+	if (AssetsToLoad.Num() > 0)
+	{
+		Handle = StreamableManager.RequestAsyncLoad(AssetsToLoad);
+	}
+	HitFXPreloadHandles.Add(HitDataTable, Handle);
+	return true;
+}
+
+void UALSFootstepSubsystem::QueueFootstepTrace(const UALSAnimNotifyFootstep* Notify, USkeletalMeshComponent* MeshComp,
+                                               const FVector& TraceStart, const FVector& TraceEnd,
+                                               ECollisionChannel TraceChannel, const FRotator& FootRotation,
+                                               float MaskCurveValue)
+{
+	check(Notify && MeshComp);
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	AActor* MeshOwner = MeshComp->GetOwner();
+
+	// Same query the synchronous kismet trace of the notify uses
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSFootstepTrace), true /*bTraceComplex*/, MeshOwner);
+	Params.bReturnPhysicalMaterial = true;
+	if (MeshOwner)
+	{
+		Params.AddIgnoredActors(MeshOwner->Children);
+	}
+
+	const uint32 TraceId = NextFootstepTraceId++;
+
+	FALSPendingFootstep& PendingFootstep = PendingFootsteps.Add(TraceId);
+	PendingFootstep.Notify = Notify;
+	PendingFootstep.MeshComp = MeshComp;
+	PendingFootstep.FootRotation = FootRotation;
+	PendingFootstep.MaskCurveValue = MaskCurveValue;
+
+	World->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, TraceChannel, Params,
+	                               FCollisionResponseParams::DefaultResponseParam, &FootstepTraceDelegate, TraceId);
+	INC_DWORD_STAT(STAT_ALSFootstepAsyncTraces);
+}
+
+void UALSFootstepSubsystem::OnFootstepTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FALSPendingFootstep PendingFootstep;
+	if (!PendingFootsteps.RemoveAndCopyValue(TraceDatum.UserData, PendingFootstep))
+	{
+		return;
+	}
+
+	const UALSAnimNotifyFootstep* Notify = PendingFootstep.Notify.Get();
+	USkeletalMeshComponent* MeshComp = PendingFootstep.MeshComp.Get();
+	if (!Notify || !MeshComp)
+	{
+		return;
+	}
+
+	const FHitResult* Hit = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits);
+
+#if ENABLE_DRAW_DEBUG
+	if (Notify->DrawDebugType != EDrawDebugTrace::None)
+	{
+		DrawDebugLineTraceSingle(GetWorld(), TraceDatum.Start, TraceDatum.End, Notify->DrawDebugType, Hit != nullptr,
+		                         Hit ? *Hit : FHitResult(), FLinearColor::Red, FLinearColor::Green, 5.0f);
+	}
+#endif
+
+	if (Hit)
+	{
+		Notify->SpawnFootstepFX(MeshComp, *Hit, PendingFootstep.FootRotation, PendingFootstep.MaskCurveValue);
+	}
+}
+
+bool UALSFootstepSubsystem::IsInFootstepFXRange(const FVector& Location)
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	// Editor previews have no player to cull against
+	if (!World->IsGameWorld())
+	{
+		return true;
+	}
+
+	UpdateViewLocations();
+
+	const float MaxDistanceSquared = FMath::Square(MaxFootstepFXDistance);
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		if (FVector::DistSquared(ViewLocation, Location) <= MaxDistanceSquared)
+		{
+			return true;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_ALSFootstepCulledByDistance);
+	return false;
+}
+
+bool UALSFootstepSubsystem::ConsumeFootstepFXBudget()
+{
+	if (FootstepFXBudgetFrame != GFrameCounter)
+	{
+		FootstepFXBudgetFrame = GFrameCounter;
+		FootstepFXThisFrame = 0;
+	}
+
+	if (FootstepFXThisFrame >= MaxFootstepFXPerFrame)
+	{
+		INC_DWORD_STAT(STAT_ALSFootstepCulledByBudget);
+		return false;
+	}
+
+	FootstepFXThisFrame++;
+	return true;
+}
+
+UAudioComponent* UALSFootstepSubsystem::PlaySoundAtLocation(USoundBase* Sound, const FVector& Location,
+                                                            const FRotator& Rotation, float VolumeMultiplier,
+                                                            float PitchMultiplier)
+{
+	UAudioComponent* AudioComponent = AcquireAudioComponent();
+	if (!AudioComponent)
+	{
+		return nullptr;
+	}
+
+	AudioComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	AudioComponent->SetWorldLocationAndRotation(Location, Rotation);
+	return PlayPooledSound(AudioComponent, Sound, VolumeMultiplier, PitchMultiplier);
+}
+
+UAudioComponent* UALSFootstepSubsystem::PlaySoundAttached(USoundBase* Sound, USceneComponent* AttachToComponent,
+                                                          FName AttachPointName, const FVector& Location,
+                                                          const FRotator& Rotation, EAttachLocation::Type LocationType,
+                                                          float VolumeMultiplier, float PitchMultiplier)
+{
+	check(AttachToComponent);
+
+	UAudioComponent* AudioComponent = AcquireAudioComponent();
+	if (!AudioComponent)
+	{
+		return nullptr;
+	}
+
+	if (LocationType == EAttachLocation::SnapToTarget || LocationType == EAttachLocation::SnapToTargetIncludingScale)
+	{
+		const FAttachmentTransformRules AttachmentRules = LocationType == EAttachLocation::SnapToTarget
+			                                                  ? FAttachmentTransformRules::SnapToTargetNotIncludingScale
+			                                                  : FAttachmentTransformRules::SnapToTargetIncludingScale;
+		AudioComponent->AttachToComponent(AttachToComponent, AttachmentRules, AttachPointName);
+	}
+	else
+	{
+		AudioComponent->AttachToComponent(AttachToComponent, FAttachmentTransformRules::KeepRelativeTransform,
+		                                  AttachPointName);
+		if (LocationType == EAttachLocation::KeepWorldPosition)
+		{
+			AudioComponent->SetWorldLocationAndRotation(Location, Rotation);
+		}
+		else
+		{
+			AudioComponent->SetRelativeLocationAndRotation(Location, Rotation);
+		}
+	}
+
+	return PlayPooledSound(AudioComponent, Sound, VolumeMultiplier, PitchMultiplier);
+}
+
+UDecalComponent* UALSFootstepSubsystem::SpawnDecalAtLocation(UMaterialInterface* DecalMaterial,
+                                                             const FVector& DecalSize, const FVector& Location,
+                                                             const FRotator& Rotation, float LifeSpan)
+{
+	if (MaxLiveDecals <= 0)
+	{
+		return nullptr;
+	}
+
+	TWeakObjectPtr<UDecalComponent>& DecalSlot = AcquireDecalSlot();
+	UDecalComponent* Decal = DecalSlot.Get();
+	if (Decal && !Decal->GetAttachParent())
+	{
+		// Move the evicted decal instead of creating a new component
+		Decal->SetDecalMaterial(DecalMaterial);
+		Decal->DecalSize = DecalSize;
+		Decal->SetWorldLocationAndRotation(Location, Rotation);
+		Decal->SetLifeSpan(LifeSpan);
+		Decal->MarkRenderStateDirty();
+		INC_DWORD_STAT(STAT_ALSFootstepDecalsReused);
+	}
+	else
+	{
+		if (Decal)
+		{
+			Decal->DestroyComponent();
+		}
+		Decal = UGameplayStatics::SpawnDecalAtLocation(GetWorld(), DecalMaterial, DecalSize, Location, Rotation,
+		                                               LifeSpan);
+	}
+
+	DecalSlot = Decal;
+	return Decal;
+}
+
+UDecalComponent* UALSFootstepSubsystem::SpawnDecalAttached(UMaterialInterface* DecalMaterial, const FVector& DecalSize,
+                                                           USceneComponent* AttachToComponent,
+                                                           const FVector& Location, const FRotator& Rotation,
+                                                           EAttachLocation::Type LocationType, float LifeSpan)
+{
+	if (MaxLiveDecals <= 0)
+	{
+		return nullptr;
+	}
+
+	TWeakObjectPtr<UDecalComponent>& DecalSlot = AcquireDecalSlot();
+	if (UDecalComponent* EvictedDecal = DecalSlot.Get())
+	{
+		EvictedDecal->DestroyComponent();
+	}
+
+	UDecalComponent* Decal = UGameplayStatics::SpawnDecalAttached(DecalMaterial, DecalSize, AttachToComponent, NAME_None,
+	                                                              Location, Rotation, LocationType, LifeSpan);
+	DecalSlot = Decal;
+	return Decal;
+}
+
+void UALSFootstepSubsystem::UpdateViewLocations()
+{
+	if (ViewLocationsFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	ViewLocationsFrame = GFrameCounter;
+	ViewLocations.Reset();
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+}
+
+UAudioComponent* UALSFootstepSubsystem::AcquireAudioComponent()
+{
+	for (UAudioComponent* AudioComponent : AudioComponentPool)
+	{
+		if (AudioComponent && !AudioComponent->IsPlaying())
+		{
+			return AudioComponent;
+		}
+	}
+
+	if (AudioComponentPool.Num() >= MaxPooledAudioComponents)
+	{
+		INC_DWORD_STAT(STAT_ALSFootstepSoundsDropped);
+		return nullptr;
+	}
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	UAudioComponent* AudioComponent = NewObject<UAudioComponent>(World->GetWorldSettings());
+	AudioComponent->bAutoActivate = false;
+	AudioComponent->bAutoDestroy = false;
+	AudioComponent->RegisterComponentWithWorld(World);
+	AudioComponentPool.Add(AudioComponent);
+	INC_DWORD_STAT(STAT_ALSFootstepPooledAudioComponents);
+	return AudioComponent;
+}
+
+TWeakObjectPtr<UDecalComponent>& UALSFootstepSubsystem::AcquireDecalSlot()
+{
+	if (DecalRing.Num() < MaxLiveDecals)
+	{
+		return DecalRing.AddDefaulted_GetRef();
+	}
+
+	DecalRingHead = DecalRingHead % DecalRing.Num();
+	TWeakObjectPtr<UDecalComponent>& DecalSlot = DecalRing[DecalRingHead];
+	DecalRingHead = (DecalRingHead + 1) % DecalRing.Num();
+	return DecalSlot;
+}
@@ -0,0 +1,223 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Subsystems/ALSLocomotionSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Library/ALSStats.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Locomotion Batch Update"), STAT_ALSLocomotionBatchUpdate, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Locomotion Batched Characters"), STAT_ALSLocomotionBatchedCharacters, STATGROUP_ALS);
+
+void FALSLocomotionTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                             const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Subsystem->UpdateEssentialValues(DeltaTime);
+	}
+}
+
+FString FALSLocomotionTickFunction::DiagnosticMessage()
+{
+	return TEXT("UALSLocomotionSubsystem::UpdateEssentialValues");
+}
+
+void UALSLocomotionSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	while (Characters.Num() > 0)
+	{
+		RemoveCharacterAt(Characters.Num() - 1);
+	}
+
+	Super::Deinitialize();
+}
+
+void UALSLocomotionSubsystem::RegisterCharacter(AALSBaseCharacter* Character)
+{
+	if (!Character || Characters.Contains(Character))
+	{
+		return;
+	}
+
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.Subsystem = this;
+		TickFunction.TickGroup = TG_PrePhysics;
+		TickFunction.bCanEverTick = true;
+		TickFunction.bStartWithTickEnabled = true;
+		TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	// Characters need their essential values before they tick
+	Character->PrimaryActorTick.AddPrerequisite(this, TickFunction);
+	Character->bEssentialValuesBatched = true;
+
+	Characters.Add(Character);
+	Velocities.AddZeroed();
+	CurrentAccelerations.AddZeroed();
+	ControlRotations.AddZeroed();
+	MaxAccelerations.AddZeroed();
+	DeltaTimes.AddZeroed();
+	AccumulatedDeltaTimes.AddZeroed();
+	PreviousVelocities.Add(Character->PreviousVelocity);
+	PreviousAimYaws.Add(Character->PreviousAimYaw);
+	AimingRotations.Add(Character->AimingRotation);
+	LastVelocityRotations.Add(Character->LastVelocityRotation);
+	LastMovementInputRotations.Add(Character->LastMovementInputRotation);
+	Accelerations.AddZeroed();
+	Speeds.AddZeroed();
+	MovementInputAmounts.AddZeroed();
+	AimYawRates.AddZeroed();
+	INC_DWORD_STAT(STAT_ALSLocomotionBatchedCharacters);
+}
+
+void UALSLocomotionSubsystem::UnregisterCharacter(AALSBaseCharacter* Character)
+{
+	const int32 Index = Characters.IndexOfByKey(Character);
+	if (Index != INDEX_NONE)
+	{
+		RemoveCharacterAt(Index);
+	}
+}
+
+void UALSLocomotionSubsystem::RemoveCharacterAt(int32 Index)
+{
+	if (AALSBaseCharacter* Character = Characters[Index].Get())
+	{
+		Character->PrimaryActorTick.RemovePrerequisite(this, TickFunction);
+		Character->bEssentialValuesBatched = false;
+	}
+
+	Characters.RemoveAtSwap(Index);
+	Velocities.RemoveAtSwap(Index);
+	CurrentAccelerations.RemoveAtSwap(Index);
+	ControlRotations.RemoveAtSwap(Index);
+	MaxAccelerations.RemoveAtSwap(Index);
+	DeltaTimes.RemoveAtSwap(Index);
+	AccumulatedDeltaTimes.RemoveAtSwap(Index);
+	PreviousVelocities.RemoveAtSwap(Index);
+	PreviousAimYaws.RemoveAtSwap(Index);
+	AimingRotations.RemoveAtSwap(Index);
+	LastVelocityRotations.RemoveAtSwap(Index);
+	LastMovementInputRotations.RemoveAtSwap(Index);
+	Accelerations.RemoveAtSwap(Index);
+	Speeds.RemoveAtSwap(Index);
+	MovementInputAmounts.RemoveAtSwap(Index);
+	AimYawRates.RemoveAtSwap(Index);
+	DEC_DWORD_STAT(STAT_ALSLocomotionBatchedCharacters);
+}
+
+void UALSLocomotionSubsystem::UpdateEssentialValues(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALSLocomotionBatchUpdate);
+
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	// Step 1: Gather the inputs on the game thread
+	for (int32 Index = Characters.Num() - 1; Index >= 0; --Index)
+	{
+		AALSBaseCharacter* Character = Characters[Index].Get();
+		if (!Character)
+		{
+			RemoveCharacterAt(Index);
+			continue;
+		}
+
+		// Same delta time as the character's own tick: dilated by the character and accumulated until its tick
+		// interval is reached
+		const FActorTickFunction& CharacterTick = Character->PrimaryActorTick;
+		if (!CharacterTick.IsTickFunctionEnabled())
+		{
+			DeltaTimes[Index] = 0.0f;
+			AccumulatedDeltaTimes[Index] = 0.0f;
+			continue;
+		}
+
+		AccumulatedDeltaTimes[Index] += DeltaTime * Character->CustomTimeDilation;
+		if (AccumulatedDeltaTimes[Index] <= 0.0f || AccumulatedDeltaTimes[Index] < CharacterTick.TickInterval)
+		{
+			DeltaTimes[Index] = 0.0f;
+			continue;
+		}
+		DeltaTimes[Index] = AccumulatedDeltaTimes[Index];
+		AccumulatedDeltaTimes[Index] = 0.0f;
+
+		Character->UpdateReplicatedEssentialValues();
+		Velocities[Index] = Character->GetVelocity();
+		CurrentAccelerations[Index] = Character->ReplicatedCurrentAcceleration;
+		ControlRotations[Index] = Character->ReplicatedControlRotation;
+		MaxAccelerations[Index] = Character->EasedMaxAcceleration;
+	}
+
+	// Step 2: Compute the essential values, same as AALSBaseCharacter::SetEssentialValues
+	ParallelFor(Characters.Num(), [this](int32 Index)
+	{
+		const float DeltaTime = DeltaTimes[Index];
+		if (DeltaTime <= 0.0f)
+		{
+			return;
+		}
+
+		const FVector& CurrentVel = Velocities[Index];
+		const FVector& CurrentAcceleration = CurrentAccelerations[Index];
+
+		AimingRotations[Index] = FMath::RInterpTo(AimingRotations[Index], ControlRotations[Index], DeltaTime, 30);
+
+		Accelerations[Index] = (CurrentVel - PreviousVelocities[Index]) / DeltaTime;
+
+		Speeds[Index] = CurrentVel.Size2D();
+		if (Speeds[Index] > 1.0f)
+		{
+			LastVelocityRotations[Index] = CurrentVel.ToOrientationRotator();
+		}
+
+		MovementInputAmounts[Index] = CurrentAcceleration.Size() / MaxAccelerations[Index];
+		if (MovementInputAmounts[Index] > 0.0f)
+		{
+			LastMovementInputRotations[Index] = CurrentAcceleration.ToOrientationRotator();
+		}
+
+		AimYawRates[Index] = FMath::Abs((AimingRotations[Index].Yaw - PreviousAimYaws[Index]) / DeltaTime);
+
+		PreviousVelocities[Index] = CurrentVel;
+		PreviousAimYaws[Index] = AimingRotations[Index].Yaw;
+	}, Characters.Num() < MinParallelBatchSize);
+
+	// Step 3: Write the results back on the game thread
+	for (int32 Index = 0; Index < Characters.Num(); ++Index)
+	{
+		if (DeltaTimes[Index] <= 0.0f)
+		{
+			continue;
+		}
+
+		AALSBaseCharacter* Character = Characters[Index].Get();
+		Character->AimingRotation = AimingRotations[Index];
+		Character->SetAcceleration(Accelerations[Index]);
+		Character->SetSpeed(Speeds[Index]);
+		Character->SetIsMoving(Speeds[Index] > 1.0f);
+		Character->LastVelocityRotation = LastVelocityRotations[Index];
+		Character->SetMovementInputAmount(MovementInputAmounts[Index]);
+		Character->SetHasMovementInput(MovementInputAmounts[Index] > 0.0f);
+		Character->LastMovementInputRotation = LastMovementInputRotations[Index];
+		Character->SetAimYawRate(AimYawRates[Index]);
+		Character->PreviousVelocity = PreviousVelocities[Index];
+		Character->PreviousAimYaw = PreviousAimYaws[Index];
+	}
+}
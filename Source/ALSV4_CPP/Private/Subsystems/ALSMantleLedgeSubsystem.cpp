@@ -0,0 +1,49 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Subsystems/ALSMantleLedgeSubsystem.h"
+
+#include "Environment/ALSMantleLedgeIndex.h"
+
+
+void UALSMantleLedgeSubsystem::RegisterLedgeIndex(AALSMantleLedgeIndex* LedgeIndex)
+{
+	if (LedgeIndex)
+	{
+		LedgeIndices.AddUnique(LedgeIndex);
+	}
+}
+
+void UALSMantleLedgeSubsystem::UnregisterLedgeIndex(AALSMantleLedgeIndex* LedgeIndex)
+{
+	LedgeIndices.RemoveSwap(LedgeIndex);
+}
+
+bool UALSMantleLedgeSubsystem::IsCovered(const FVector& Location) const
+{
+	for (const TWeakObjectPtr<AALSMantleLedgeIndex>& LedgeIndex : LedgeIndices)
+	{
+		if (LedgeIndex.IsValid() && LedgeIndex->IsCovered(Location))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UALSMantleLedgeSubsystem::GetLedgesInBox(const FBox& Box, TArray<const FALSMantleLedge*>& OutLedges) const
+{
+	for (const TWeakObjectPtr<AALSMantleLedgeIndex>& LedgeIndex : LedgeIndices)
+	{
+		if (LedgeIndex.IsValid())
+		{
+			LedgeIndex->GetLedgesInBox(Box, OutLedges);
+		}
+	}
+}
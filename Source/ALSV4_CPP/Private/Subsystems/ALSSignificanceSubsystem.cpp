@@ -0,0 +1,187 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Subsystems/ALSSignificanceSubsystem.h"
+
+#include "Character/ALSBaseCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Library/ALSMathLibrary.h"
+#include "Library/ALSStats.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_ALSSignificanceUpdate, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Level Changes"), STAT_ALSSignificanceLevelChanges, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance Registered Characters"), STAT_ALSSignificanceCharacters, STATGROUP_ALS);
+
+UALSSignificanceSubsystem::UALSSignificanceSubsystem()
+{
+	// Defaults, overridden by the game config
+	SignificanceLevels.SetNum(3);
+	SignificanceLevels[1].MinDistance = 2000.0f;
+	SignificanceLevels[1].ActorTickInterval = 1.0f / 30.0f;
+	SignificanceLevels[1].MeshTickInterval = 1.0f / 30.0f;
+	SignificanceLevels[2].MinDistance = 5000.0f;
+	SignificanceLevels[2].ActorTickInterval = 0.1f;
+	SignificanceLevels[2].MeshTickInterval = 0.1f;
+	SignificanceLevels[2].MovementTickInterval = 0.05f;
+}
+
+void UALSSignificanceSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_ALSSignificanceCharacters, Characters.Num());
+	Characters.Empty();
+
+	Super::Deinitialize();
+}
+
+void UALSSignificanceSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceLastUpdate += DeltaTime;
+	if (TimeSinceLastUpdate < UpdateInterval)
+	{
+		return;
+	}
+	TimeSinceLastUpdate = 0.0f;
+
+	SCOPE_CYCLE_COUNTER(STAT_ALSSignificanceUpdate);
+
+	for (int32 Index = Characters.Num() - 1; Index >= 0; --Index)
+	{
+		FALSSignificantCharacter& Entry = Characters[Index];
+		AALSBaseCharacter* Character = Entry.Character.Get();
+		if (!Character)
+		{
+			Characters.RemoveAtSwap(Index);
+			DEC_DWORD_STAT(STAT_ALSSignificanceCharacters);
+			continue;
+		}
+
+		const int32 Level = CalculateSignificanceLevel(Character);
+		if (Level != Entry.Level)
+		{
+			Entry.Level = Level;
+			ApplySignificanceLevel(Entry);
+			INC_DWORD_STAT(STAT_ALSSignificanceLevelChanges);
+		}
+	}
+}
+
+ETickableTickType UALSSignificanceSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UALSSignificanceSubsystem::IsTickable() const
+{
+	return Characters.Num() > 0 && SignificanceLevels.Num() > 0;
+}
+
+TStatId UALSSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UALSSignificanceSubsystem::RegisterCharacter(AALSBaseCharacter* Character)
+{
+	if (!Character || Characters.ContainsByPredicate([Character](const FALSSignificantCharacter& Entry)
+	{
+		return Entry.Character == Character;
+	}))
+	{
+		return;
+	}
+
+	FALSSignificantCharacter& Entry = Characters.AddDefaulted_GetRef();
+	Entry.Character = Character;
+	Entry.ActorTickInterval = Character->GetActorTickInterval();
+	Entry.MeshTickInterval = Character->GetMesh()->GetComponentTickInterval();
+	Entry.MovementTickInterval = Character->GetCharacterMovement()->GetComponentTickInterval();
+	INC_DWORD_STAT(STAT_ALSSignificanceCharacters);
+}
+
+void UALSSignificanceSubsystem::UnregisterCharacter(AALSBaseCharacter* Character)
+{
+	const int32 Index = Characters.IndexOfByPredicate([Character](const FALSSignificantCharacter& Entry)
+	{
+		return Entry.Character == Character;
+	});
+
+	if (Index != INDEX_NONE)
+	{
+		RestoreTickIntervals(Characters[Index]);
+		Characters.RemoveAtSwap(Index);
+		DEC_DWORD_STAT(STAT_ALSSignificanceCharacters);
+	}
+}
+
+int32 UALSSignificanceSubsystem::GetSignificanceLevel(const AALSBaseCharacter* Character) const
+{
+	const FALSSignificantCharacter* Entry = Characters.FindByPredicate([Character](const FALSSignificantCharacter& It)
+	{
+		return It.Character == Character;
+	});
+	return Entry ? Entry->Level : INDEX_NONE;
+}
+
+int32 UALSSignificanceSubsystem::CalculateSignificanceLevel(const AALSBaseCharacter* Character) const
+{
+	if (Character->IsPlayerControlled())
+	{
+		return 0;
+	}
+
+	// Levels are sorted by ascending distance, so the last reached one wins
+	const float Distance = UALSMathLibrary::GetClosestViewDistance(GetWorld(), Character->GetActorLocation());
+	int32 Level = 0;
+	for (int32 Index = 1; Index < SignificanceLevels.Num(); ++Index)
+	{
+		if (Distance >= SignificanceLevels[Index].MinDistance)
+		{
+			Level = Index;
+		}
+	}
+
+	// Nothing is rendered on dedicated servers, only the distance matters there
+	if (!IsRunningDedicatedServer() && !Character->GetMesh()->WasRecentlyRendered(NotRenderedTime))
+	{
+		Level = FMath::Max(Level, FMath::Min(NotRenderedLevel, SignificanceLevels.Num() - 1));
+	}
+
+	return Level;
+}
+
+void UALSSignificanceSubsystem::ApplySignificanceLevel(const FALSSignificantCharacter& Entry) const
+{
+	if (Entry.Level == 0)
+	{
+		RestoreTickIntervals(Entry);
+		return;
+	}
+
+	// Never tick faster than the character was set up to
+	AALSBaseCharacter* Character = Entry.Character.Get();
+	const FALSSignificanceLevel& Settings = SignificanceLevels[Entry.Level];
+	Character->SetActorTickInterval(FMath::Max(Settings.ActorTickInterval, Entry.ActorTickInterval));
+	Character->GetMesh()->SetComponentTickInterval(FMath::Max(Settings.MeshTickInterval, Entry.MeshTickInterval));
+	Character->GetCharacterMovement()->SetComponentTickInterval(
+		FMath::Max(Settings.MovementTickInterval, Entry.MovementTickInterval));
+}
+
+void UALSSignificanceSubsystem::RestoreTickIntervals(const FALSSignificantCharacter& Entry)
+{
+	AALSBaseCharacter* Character = Entry.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	Character->SetActorTickInterval(Entry.ActorTickInterval);
+	Character->GetMesh()->SetComponentTickInterval(Entry.MeshTickInterval);
+	Character->GetCharacterMovement()->SetComponentTickInterval(Entry.MovementTickInterval);
+}
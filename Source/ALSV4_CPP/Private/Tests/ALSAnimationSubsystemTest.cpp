@@ -0,0 +1,69 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Character/ALSBaseCharacter.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Tests/ALSAutomationTestUtils.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+
+namespace
+{
+	constexpr int32 NumBenchmarkCharacters = 300;
+
+	/** Switch the anim instances of the characters between the batched and per-instance update */
+	TFunction<bool()> SetBatchedUpdate(const TSharedRef<FALSTestCharacterList>& Characters, bool bBatched)
+	{
+		return [Characters, bBatched]()
+		{
+			for (const TWeakObjectPtr<AALSBaseCharacter>& Character : *Characters)
+			{
+				UALSCharacterAnimInstance* AnimInstance = Character.IsValid()
+					                                          ? Cast<UALSCharacterAnimInstance>(
+						                                          Character->GetMesh()->GetAnimInstance())
+					                                          : nullptr;
+				if (AnimInstance)
+				{
+					AnimInstance->SetUseBatchedUpdate(bBatched);
+				}
+			}
+			return true;
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSAnimationBatchBenchmark, "ALS.Animation.BatchedUpdateBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FALSAnimationBatchBenchmark::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FALSTestCharacterList> Characters = MakeShared<FALSTestCharacterList>();
+
+	FAutomationEditorCommonUtils::LoadMap(ALSAutomationTest::DemoMap);
+	ADD_LATENT_AUTOMATION_COMMAND(FALSStartPIECommand(PIE_Standalone, 1));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSSpawnCharactersCommand(this, Characters, NumBenchmarkCharacters));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(SetBatchedUpdate(Characters, false)));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSMeasureFrameTimes(
+		this, FString::Printf(TEXT("%d characters, per instance update"), NumBenchmarkCharacters)));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(SetBatchedUpdate(Characters, true)));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSMeasureFrameTimes(
+		this, FString::Printf(TEXT("%d characters, batched update"), NumBenchmarkCharacters)));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+#endif
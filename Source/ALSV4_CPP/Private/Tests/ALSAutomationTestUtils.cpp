@@ -0,0 +1,154 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Tests/ALSAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Character/ALSBaseCharacter.h"
+
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerStart.h"
+#include "Misc/App.h"
+
+const TCHAR* ALSAutomationTest::DemoMap = TEXT("/ALSV4_CPP/AdvancedLocomotionV4/Levels/ALS_DemoLevel");
+
+UWorld* ALSAutomationTest::FindPIEWorld(ENetMode NetMode)
+{
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if (Context.WorldType == EWorldType::PIE && Context.World() && Context.World()->GetNetMode() == NetMode)
+		{
+			return Context.World();
+		}
+	}
+	return nullptr;
+}
+
+bool ALSAutomationTest::SpawnCharacters(UWorld* World, int32 NumCharacters, float Spacing,
+                                        TArray<AALSBaseCharacter*>& OutCharacters)
+{
+	const AGameModeBase* GameMode = World->GetAuthGameMode();
+	UClass* CharacterClass = GameMode ? GameMode->DefaultPawnClass.Get() : nullptr;
+	if (!CharacterClass || !CharacterClass->IsChildOf(AALSBaseCharacter::StaticClass()))
+	{
+		return false;
+	}
+
+	FVector Center = FVector::ZeroVector;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Center = It->GetActorLocation();
+		break;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	const int32 RowSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumCharacters)));
+	const float HalfExtent = (RowSize - 1) * Spacing * 0.5f;
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const FVector Location = Center + FVector((Index % RowSize) * Spacing - HalfExtent,
+		                                          (Index / RowSize) * Spacing - HalfExtent, 0.0f);
+		if (AALSBaseCharacter* Character = World->SpawnActor<AALSBaseCharacter>(
+			CharacterClass, Location, FRotator::ZeroRotator, SpawnParameters))
+		{
+			// Characters without a controller don't move
+			Character->SpawnDefaultController();
+			OutCharacters.Add(Character);
+		}
+	}
+	return true;
+}
+
+bool FALSStartPIECommand::Update()
+{
+	ULevelEditorPlaySettings* PlaySettings = NewObject<ULevelEditorPlaySettings>();
+	PlaySettings->SetPlayNetMode(NetMode);
+	PlaySettings->SetPlayNumberOfClients(NumPlayers);
+	PlaySettings->bLaunchSeparateServer = false;
+	PlaySettings->SetRunUnderOneProcess(true);
+
+	FRequestPlaySessionParams Params;
+	Params.WorldType = EPlaySessionWorldType::PlayInEditor;
+	Params.EditorPlaySettings = PlaySettings;
+	GEditor->RequestPlaySession(Params);
+	return true;
+}
+
+FALSSpawnCharactersCommand::FALSSpawnCharactersCommand(FAutomationTestBase* InTest,
+                                                       const TSharedRef<FALSTestCharacterList>& InCharacters,
+                                                       int32 InNumCharacters, float InSpacing)
+	: Test(InTest), Characters(InCharacters), NumCharacters(InNumCharacters), Spacing(InSpacing)
+{
+}
+
+bool FALSSpawnCharactersCommand::Update()
+{
+	UWorld* World = ALSAutomationTest::FindPIEWorld(NM_Standalone);
+	if (!World)
+	{
+		if (GetCurrentRunTime() > 30.0)
+		{
+			Test->AddError(TEXT("The play in editor session didn't start within 30 seconds"));
+			return true;
+		}
+		return false;
+	}
+
+	for (const TWeakObjectPtr<AALSBaseCharacter>& Character : *Characters)
+	{
+		if (Character.IsValid())
+		{
+			Character->Destroy();
+		}
+	}
+	Characters->Reset();
+
+	TArray<AALSBaseCharacter*> SpawnedCharacters;
+	if (!ALSAutomationTest::SpawnCharacters(World, NumCharacters, Spacing, SpawnedCharacters))
+	{
+		Test->AddError(TEXT("The game mode of the demo level doesn't spawn ALS characters"));
+		return true;
+	}
+
+	Characters->Append(SpawnedCharacters);
+	return true;
+}
+
+FALSMeasureFrameTimes::FALSMeasureFrameTimes(FAutomationTestBase* InTest, const FString& InLabel, int32 InNumFrames,
+                                             int32 InNumWarmUpFrames)
+	: Test(InTest), Label(InLabel), NumFrames(InNumFrames), NumWarmUpFrames(InNumWarmUpFrames)
+{
+}
+
+bool FALSMeasureFrameTimes::Update()
+{
+	if (Frame++ < NumWarmUpFrames)
+	{
+		return false;
+	}
+
+	GameThreadMilliseconds += FPlatformTime::ToMilliseconds(GGameThreadTime);
+	FrameMilliseconds += FApp::GetDeltaTime() * 1000.0;
+
+	if (Frame < NumWarmUpFrames + NumFrames)
+	{
+		return false;
+	}
+
+	Test->AddInfo(FString::Printf(TEXT("%s: %.3f ms game thread, %.3f ms frame, averaged over %d frames"), *Label,
+	                              GameThreadMilliseconds / NumFrames, FrameMilliseconds / NumFrames, NumFrames));
+	return true;
+}
+
+#endif
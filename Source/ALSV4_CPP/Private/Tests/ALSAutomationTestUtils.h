@@ -0,0 +1,94 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Engine/EngineBaseTypes.h"
+#include "Settings/LevelEditorPlaySettings.h"
+
+// forward declarations
+class AALSBaseCharacter;
+class UWorld;
+
+namespace ALSAutomationTest
+{
+	/** Demo level of the plugin content, its game mode spawns ALS characters */
+	extern const TCHAR* DemoMap;
+
+	/** Play in editor world running with the net mode, null if there is none */
+	UWorld* FindPIEWorld(ENetMode NetMode);
+
+	/**
+	 * Spawn ALS characters of the game mode's default pawn class on a square grid centered on the first player start,
+	 * possessed by their default controller. Returns false if the game mode doesn't spawn ALS characters.
+	 */
+	bool SpawnCharacters(UWorld* World, int32 NumCharacters, float Spacing, TArray<AALSBaseCharacter*>& OutCharacters);
+}
+
+/** Start a play in editor session with the net mode and number of players, running under one process */
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FALSStartPIECommand, EPlayNetMode, NetMode, int32, NumPlayers);
+
+/** Characters spawned by a test, shared by its latent commands */
+using FALSTestCharacterList = TArray<TWeakObjectPtr<AALSBaseCharacter>>;
+
+/**
+ * Wait for the standalone play in editor world, destroy the characters of the list and spawn the number of characters
+ * in their place
+ */
+class FALSSpawnCharactersCommand : public IAutomationLatentCommand
+{
+public:
+	FALSSpawnCharactersCommand(FAutomationTestBase* InTest, const TSharedRef<FALSTestCharacterList>& InCharacters,
+	                           int32 InNumCharacters, float InSpacing = 200.0f);
+
+	virtual bool Update() override;
+
+private:
+	FAutomationTestBase* Test;
+
+	TSharedRef<FALSTestCharacterList> Characters;
+
+	int32 NumCharacters;
+
+	float Spacing;
+};
+
+/**
+ * Average the game thread and frame times over a number of frames, after letting the previous changes settle for
+ * some frames, and report them with the label
+ */
+class FALSMeasureFrameTimes : public IAutomationLatentCommand
+{
+public:
+	FALSMeasureFrameTimes(FAutomationTestBase* InTest, const FString& InLabel, int32 InNumFrames = 300,
+	                      int32 InNumWarmUpFrames = 60);
+
+	virtual bool Update() override;
+
+private:
+	FAutomationTestBase* Test;
+
+	FString Label;
+
+	int32 NumFrames;
+
+	int32 NumWarmUpFrames;
+
+	int32 Frame = 0;
+
+	double GameThreadMilliseconds = 0.0;
+
+	double FrameMilliseconds = 0.0;
+};
+
+#endif
@@ -0,0 +1,160 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Allowed difference to the scalar path, covers the quaternion and rotation matrix rounding differently */
+	constexpr float UnrotateTolerance = 1.e-5f;
+
+	FRotator RandomRotator(FRandomStream& Stream, bool bYawOnly)
+	{
+		return bYawOnly
+			       ? FRotator(0.0f, Stream.FRandRange(-180.0f, 180.0f), 0.0f)
+			       : FRotator(Stream.FRandRange(-90.0f, 90.0f), Stream.FRandRange(-180.0f, 180.0f),
+			                  Stream.FRandRange(-180.0f, 180.0f));
+	}
+
+	/**
+	 * Non zero vectors, including the axes and diagonals where the clamps of the blend channels are exactly at their
+	 * bounds
+	 */
+	FVector RandomDirection(FRandomStream& Stream)
+	{
+		switch (Stream.RandRange(0, 3))
+		{
+		case 0:
+			{
+				const int32 X = Stream.RandRange(-1, 1);
+				const int32 Y = X == 0 ? (Stream.RandBool() ? 1 : -1) : Stream.RandRange(-1, 1);
+				return FVector(X, Y, 0.0f) * Stream.FRandRange(10.0f, 600.0f);
+			}
+		case 1:
+			return Stream.GetUnitVector() * Stream.FRandRange(10.0f, 600.0f);
+		default:
+			return FVector(Stream.FRandRange(-600.0f, 600.0f), Stream.FRandRange(-600.0f, 600.0f), 0.0f);
+		}
+	}
+
+	/** Velocity blend as computed before it was vectorized, with the rotator of the actor */
+	FALSVelocityBlend ScalarVelocityBlend(const FVector& Velocity, const FRotator& ActorRotation)
+	{
+		const FVector LocRelativeVelocityDir = ActorRotation.UnrotateVector(Velocity.GetSafeNormal(0.1f));
+		const float Sum = FMath::Abs(LocRelativeVelocityDir.X) + FMath::Abs(LocRelativeVelocityDir.Y) +
+			FMath::Abs(LocRelativeVelocityDir.Z);
+		const FVector RelativeDirection = LocRelativeVelocityDir / Sum;
+		FALSVelocityBlend Result;
+		Result.F = FMath::Clamp(RelativeDirection.X, 0.0f, 1.0f);
+		Result.B = FMath::Abs(FMath::Clamp(RelativeDirection.X, -1.0f, 0.0f));
+		Result.L = FMath::Abs(FMath::Clamp(RelativeDirection.Y, -1.0f, 0.0f));
+		Result.R = FMath::Clamp(RelativeDirection.Y, 0.0f, 1.0f);
+		return Result;
+	}
+
+	/** Relative acceleration amount as computed before it used the actor quaternion */
+	FVector ScalarRelativeAccelerationAmount(const FALSAnimMovementInput& Input, const FRotator& ActorRotation)
+	{
+		if (FVector::DotProduct(Input.Acceleration, Input.Velocity) > 0.0f)
+		{
+			const float MaxAcc = Input.MaxAcceleration;
+			return ActorRotation.UnrotateVector(Input.Acceleration.GetClampedToMaxSize(MaxAcc) / MaxAcc);
+		}
+
+		const float MaxBrakingDec = Input.MaxBrakingDeceleration;
+		return ActorRotation.UnrotateVector(Input.Acceleration.GetClampedToMaxSize(MaxBrakingDec) / MaxBrakingDec);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSVelocityBlendTest, "ALS.Animation.VelocityBlend",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FALSVelocityBlendTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Stream(20201);
+	float MaxError = 0.0f;
+	int32 NumMismatches = 0;
+
+	for (int32 Iteration = 0; Iteration < 10000; ++Iteration)
+	{
+		// Without rotation both paths unrotate exactly, the clamps have to match bit for bit
+		const bool bUnrotated = Iteration % 4 == 0;
+		const FRotator ActorRotation = bUnrotated ? FRotator::ZeroRotator : RandomRotator(Stream, Iteration % 4 == 1);
+
+		FALSAnimMovementInput Input;
+		Input.Velocity = RandomDirection(Stream);
+		Input.ActorQuat = ActorRotation.Quaternion();
+
+		float Blend[4];
+		VectorStore(UALSCharacterAnimInstance::CalculateVelocityBlend(Input), Blend);
+		const FALSVelocityBlend Expected = ScalarVelocityBlend(Input.Velocity, ActorRotation);
+		const float ExpectedBlend[4] = {Expected.F, Expected.B, Expected.L, Expected.R};
+
+		for (int32 Channel = 0; Channel < 4; ++Channel)
+		{
+			const float Error = FMath::Abs(Blend[Channel] - ExpectedBlend[Channel]);
+			MaxError = FMath::Max(MaxError, Error);
+			const bool bMatches = bUnrotated ? Blend[Channel] == ExpectedBlend[Channel] : Error <= UnrotateTolerance;
+			if ((!bMatches || Blend[Channel] < 0.0f || Blend[Channel] > 1.0f) && NumMismatches++ < 10)
+			{
+				AddError(FString::Printf(
+					TEXT("Channel %d of the velocity blend of %s at %s is %.9g, the scalar blend is %.9g"),
+					Channel, *Input.Velocity.ToString(), *ActorRotation.ToString(), Blend[Channel],
+					ExpectedBlend[Channel]));
+			}
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("Max difference to the scalar velocity blend: %g"), MaxError));
+	return NumMismatches == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSRelativeAccelerationTest, "ALS.Animation.RelativeAccelerationAmount",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FALSRelativeAccelerationTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Stream(20202);
+	float MaxError = 0.0f;
+	int32 NumMismatches = 0;
+
+	for (int32 Iteration = 0; Iteration < 10000; ++Iteration)
+	{
+		const FRotator ActorRotation = RandomRotator(Stream, Iteration % 2 == 0);
+
+		// Accelerating and braking, below and above the limits
+		FALSAnimMovementInput Input;
+		Input.Velocity = RandomDirection(Stream);
+		Input.Acceleration = RandomDirection(Stream) * Stream.FRandRange(0.5f, 5.0f);
+		Input.MaxAcceleration = Stream.FRandRange(500.0f, 2500.0f);
+		Input.MaxBrakingDeceleration = Stream.FRandRange(500.0f, 2500.0f);
+		Input.ActorQuat = ActorRotation.Quaternion();
+
+		const FVector Amount = UALSCharacterAnimInstance::CalculateRelativeAccelerationAmount(Input);
+		const FVector Expected = ScalarRelativeAccelerationAmount(Input, ActorRotation);
+
+		const float Error = (Amount - Expected).GetAbsMax();
+		MaxError = FMath::Max(MaxError, Error);
+		if (Error > UnrotateTolerance && NumMismatches++ < 10)
+		{
+			AddError(FString::Printf(
+				TEXT("Relative acceleration amount of %s at %s is %s, the scalar amount is %s"),
+				*Input.Acceleration.ToString(), *ActorRotation.ToString(), *Amount.ToString(), *Expected.ToString()));
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("Max difference to the rotator unrotate: %g"), MaxError));
+	return NumMismatches == 0;
+}
+
+#endif
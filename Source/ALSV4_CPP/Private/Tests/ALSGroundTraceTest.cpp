@@ -0,0 +1,71 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Character/ALSBaseCharacter.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Tests/ALSAutomationTestUtils.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+
+namespace
+{
+	/** Switch the anim instances of the characters between synchronous and asynchronous ground traces */
+	TFunction<bool()> SetAsyncGroundTraces(const TSharedRef<FALSTestCharacterList>& Characters, bool bAsync)
+	{
+		return [Characters, bAsync]()
+		{
+			for (const TWeakObjectPtr<AALSBaseCharacter>& Character : *Characters)
+			{
+				UALSCharacterAnimInstance* AnimInstance = Character.IsValid()
+					                                          ? Cast<UALSCharacterAnimInstance>(
+						                                          Character->GetMesh()->GetAnimInstance())
+					                                          : nullptr;
+				if (AnimInstance)
+				{
+					AnimInstance->SetUseAsyncGroundTraces(bAsync);
+				}
+			}
+			return true;
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSGroundTraceBenchmark, "ALS.Animation.AsyncGroundTraceBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FALSGroundTraceBenchmark::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FALSTestCharacterList> Characters = MakeShared<FALSTestCharacterList>();
+
+	FAutomationEditorCommonUtils::LoadMap(ALSAutomationTest::DemoMap);
+	ADD_LATENT_AUTOMATION_COMMAND(FALSStartPIECommand(PIE_Standalone, 1));
+
+	for (const int32 NumCharacters : {50, 100, 200})
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FALSSpawnCharactersCommand(this, Characters, NumCharacters));
+
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(SetAsyncGroundTraces(Characters, false)));
+		ADD_LATENT_AUTOMATION_COMMAND(FALSMeasureFrameTimes(
+			this, FString::Printf(TEXT("%d characters, synchronous ground traces"), NumCharacters)));
+
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand(SetAsyncGroundTraces(Characters, true)));
+		ADD_LATENT_AUTOMATION_COMMAND(FALSMeasureFrameTimes(
+			this, FString::Printf(TEXT("%d characters, asynchronous ground traces"), NumCharacters)));
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+#endif
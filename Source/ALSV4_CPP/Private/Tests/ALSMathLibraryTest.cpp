@@ -0,0 +1,210 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Library/ALSMathLibrary.h"
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Allowed difference to the scalar interpolation, covers a fused multiply add rounding differently */
+	constexpr float InterpTolerance = 1.e-6f;
+
+	bool IsNearlyEqualInterp(float Vector, float Scalar)
+	{
+		return FMath::Abs(Vector - Scalar) <= InterpTolerance * FMath::Max(1.0f, FMath::Abs(Scalar));
+	}
+
+	/** Current value close enough to the target to exercise the snap of both interpolations */
+	float RandomCurrent(FRandomStream& Stream, float Target)
+	{
+		switch (Stream.RandRange(0, 3))
+		{
+		case 0:
+			return Target;
+		case 1:
+			return Target + Stream.FRandRange(-1.e-4f, 1.e-4f);
+		default:
+			return Stream.FRandRange(-2.0f, 2.0f);
+		}
+	}
+
+	/** Interp speeds including the jump to target and a clamped alpha */
+	float RandomInterpSpeed(FRandomStream& Stream)
+	{
+		switch (Stream.RandRange(0, 4))
+		{
+		case 0:
+			return 0.0f;
+		case 1:
+			return -Stream.FRandRange(0.0f, 10.0f);
+		case 2:
+			return Stream.FRandRange(100.0f, 1000.0f);
+		default:
+			return Stream.FRandRange(0.0f, 50.0f);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSVectorInterpToTest, "ALS.MathLibrary.VectorInterpTo",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FALSVectorInterpToTest::RunTest(const FString& Parameters)
+{
+	FRandomStream Stream(20211);
+	float MaxError = 0.0f;
+	int32 NumMismatches = 0;
+
+	for (int32 Iteration = 0; Iteration < 10000; ++Iteration)
+	{
+		float Target[4];
+		float Current[4];
+		for (int32 Channel = 0; Channel < 4; ++Channel)
+		{
+			Target[Channel] = Stream.FRandRange(-2.0f, 2.0f);
+			Current[Channel] = RandomCurrent(Stream, Target[Channel]);
+		}
+		const float DeltaTime = Stream.FRandRange(0.0f, 0.1f);
+		const float InterpSpeed = RandomInterpSpeed(Stream);
+
+		float Result[4];
+		VectorStore(UALSMathLibrary::VectorInterpTo(VectorLoad(Current), VectorLoad(Target), DeltaTime, InterpSpeed),
+		            Result);
+
+		for (int32 Channel = 0; Channel < 4; ++Channel)
+		{
+			const float Expected = FMath::FInterpTo(Current[Channel], Target[Channel], DeltaTime, InterpSpeed);
+			MaxError = FMath::Max(MaxError, FMath::Abs(Result[Channel] - Expected));
+			if (!IsNearlyEqualInterp(Result[Channel], Expected) && NumMismatches++ < 10)
+			{
+				AddError(FString::Printf(
+					TEXT("Channel %d of FInterpTo(%.9g, %.9g, %.9g, %.9g) is %.9g, VectorInterpTo returned %.9g"),
+					Channel, Current[Channel], Target[Channel], DeltaTime, InterpSpeed, Expected, Result[Channel]));
+			}
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("Max difference to FInterpTo: %g"), MaxError));
+	return NumMismatches == 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSLeanInterpToTest, "ALS.MathLibrary.LeanInterpTo",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FALSLeanInterpToTest::RunTest(const FString& Parameters)
+{
+	// Lean amounts interpolate LR and FB in the first two channels and leave the padding channels at zero
+	FRandomStream Stream(20212);
+	float LR = 0.0f;
+	float FB = 0.0f;
+	float ScalarLR = 0.0f;
+	float ScalarFB = 0.0f;
+
+	for (int32 Frame = 0; Frame < 1000; ++Frame)
+	{
+		const float TargetLR = Stream.FRandRange(-1.0f, 1.0f);
+		const float TargetFB = Stream.FRandRange(-1.0f, 1.0f);
+		const float DeltaTime = Stream.FRandRange(1.0f / 240.0f, 1.0f / 15.0f);
+		const float InterpSpeed = 4.0f;
+
+		float Channels[4];
+		VectorStore(UALSMathLibrary::VectorInterpTo(MakeVectorRegister(LR, FB, 0.0f, 0.0f),
+		                                            MakeVectorRegister(TargetLR, TargetFB, 0.0f, 0.0f),
+		                                            DeltaTime, InterpSpeed), Channels);
+		LR = Channels[0];
+		FB = Channels[1];
+		ScalarLR = FMath::FInterpTo(ScalarLR, TargetLR, DeltaTime, InterpSpeed);
+		ScalarFB = FMath::FInterpTo(ScalarFB, TargetFB, DeltaTime, InterpSpeed);
+
+		// Frame to frame accumulation must not drift away from the scalar path
+		if (!IsNearlyEqualInterp(LR, ScalarLR) || !IsNearlyEqualInterp(FB, ScalarFB) ||
+			Channels[2] != 0.0f || Channels[3] != 0.0f)
+		{
+			AddError(FString::Printf(TEXT("Frame %d: lean (%.9g, %.9g), FInterpTo lean (%.9g, %.9g)"),
+			                         Frame, LR, FB, ScalarLR, ScalarFB));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSVectorInterpToBenchmark, "ALS.MathLibrary.VectorInterpToBenchmark",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FALSVectorInterpToBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumValues = 4096;
+	constexpr int32 NumIterations = 256;
+	constexpr float DeltaTime = 1.0f / 60.0f;
+	constexpr float InterpSpeed = 12.0f;
+
+	FRandomStream Stream(20213);
+	TArray<FVector4> Targets;
+	Targets.SetNumUninitialized(NumValues);
+	for (FVector4& Target : Targets)
+	{
+		Target = FVector4(Stream.FRandRange(0.0f, 1.0f), Stream.FRandRange(0.0f, 1.0f),
+		                  Stream.FRandRange(0.0f, 1.0f), Stream.FRandRange(0.0f, 1.0f));
+	}
+	TArray<FVector4> ScalarValues;
+	ScalarValues.SetNumZeroed(NumValues);
+	TArray<FVector4> VectorValues;
+	VectorValues.SetNumZeroed(NumValues);
+
+	// Velocity blend shaped data: four channels interpolated towards a new target every frame
+	const double ScalarStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 Index = 0; Index < NumValues; ++Index)
+		{
+			FVector4& Value = ScalarValues[Index];
+			const FVector4& Target = Targets[(Index + Iteration) % NumValues];
+			Value.X = FMath::FInterpTo(Value.X, Target.X, DeltaTime, InterpSpeed);
+			Value.Y = FMath::FInterpTo(Value.Y, Target.Y, DeltaTime, InterpSpeed);
+			Value.Z = FMath::FInterpTo(Value.Z, Target.Z, DeltaTime, InterpSpeed);
+			Value.W = FMath::FInterpTo(Value.W, Target.W, DeltaTime, InterpSpeed);
+		}
+	}
+	const double ScalarSeconds = FPlatformTime::Seconds() - ScalarStart;
+
+	const double VectorStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 Index = 0; Index < NumValues; ++Index)
+		{
+			FVector4& Value = VectorValues[Index];
+			const FVector4& Target = Targets[(Index + Iteration) % NumValues];
+			VectorStore(UALSMathLibrary::VectorInterpTo(VectorLoad(&Value.X), VectorLoad(&Target.X),
+			                                            DeltaTime, InterpSpeed), &Value.X);
+		}
+	}
+	const double VectorSeconds = FPlatformTime::Seconds() - VectorStart;
+
+	// Also keeps the compiler from dropping either loop
+	float MaxError = 0.0f;
+	for (int32 Index = 0; Index < NumValues; ++Index)
+	{
+		for (int32 Channel = 0; Channel < 4; ++Channel)
+		{
+			MaxError = FMath::Max(MaxError, FMath::Abs(VectorValues[Index][Channel] - ScalarValues[Index][Channel]));
+		}
+	}
+
+	const int32 NumInterps = NumValues * NumIterations;
+	AddInfo(FString::Printf(TEXT("4x FInterpTo: %.2f ns, VectorInterpTo: %.2f ns per interpolation, max difference %g"),
+	                        ScalarSeconds * 1.e9 / NumInterps, VectorSeconds * 1.e9 / NumInterps, MaxError));
+	TestTrue(TEXT("VectorInterpTo matches FInterpTo"), MaxError <= InterpTolerance);
+	return true;
+}
+
+#endif
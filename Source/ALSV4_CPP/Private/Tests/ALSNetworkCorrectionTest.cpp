@@ -0,0 +1,167 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Character/ALSBaseCharacter.h"
+#include "Character/ALSCharacterMovementComponent.h"
+#include "Tests/ALSAutomationTestUtils.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+
+namespace
+{
+	using ALSAutomationTest::FindPIEWorld;
+
+	/** Latency added in each direction, 150 ms round trip */
+	constexpr int32 PacketLagMs = 75;
+
+	constexpr int32 PacketLossPercentage = 2;
+
+	constexpr double MeasureSeconds = 60.0;
+
+	AALSBaseCharacter* FindClientCharacter()
+	{
+		UWorld* ClientWorld = FindPIEWorld(NM_Client);
+		const APlayerController* PlayerController = ClientWorld ? ClientWorld->GetFirstPlayerController() : nullptr;
+		return PlayerController ? Cast<AALSBaseCharacter>(PlayerController->GetPawn()) : nullptr;
+	}
+
+	void SetNetworkEmulation(int32 LagMs, int32 LossPercentage)
+	{
+		for (UWorld* World : {FindPIEWorld(NM_ListenServer), FindPIEWorld(NM_Client)})
+		{
+			if (World)
+			{
+				GEngine->Exec(World, *FString::Printf(TEXT("Net PktLag=%d"), LagMs));
+				GEngine->Exec(World, *FString::Printf(TEXT("Net PktLoss=%d"), LossPercentage));
+			}
+		}
+	}
+}
+
+/** Wait until the client possesses its character, then turn the network emulation on */
+class FALSWaitForClientCharacter : public IAutomationLatentCommand
+{
+public:
+	explicit FALSWaitForClientCharacter(FAutomationTestBase* InTest) : Test(InTest)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		if (FindClientCharacter())
+		{
+			SetNetworkEmulation(PacketLagMs, PacketLossPercentage);
+			return true;
+		}
+
+		if (GetCurrentRunTime() > 30.0)
+		{
+			Test->AddError(TEXT("The client didn't possess an ALS character within 30 seconds"));
+			return true;
+		}
+		return false;
+	}
+
+private:
+	FAutomationTestBase* Test;
+};
+
+/**
+ * Drive the client character with changing movement input, gaits and rolls, and count the position corrections it
+ * receives from the server
+ */
+class FALSMeasureClientCorrections : public IAutomationLatentCommand
+{
+public:
+	explicit FALSMeasureClientCorrections(FAutomationTestBase* InTest) : Test(InTest)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		AALSBaseCharacter* Character = FindClientCharacter();
+		const UALSCharacterMovementComponent* CharacterMovement =
+			Character ? Cast<UALSCharacterMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+		if (!CharacterMovement)
+		{
+			Test->AddError(TEXT("The client lost its ALS character"));
+			return true;
+		}
+
+		if (!bStarted)
+		{
+			bStarted = true;
+			StartCorrections = CharacterMovement->GetNumClientPositionCorrections();
+		}
+
+		const double RunTime = GetCurrentRunTime();
+
+		if (RunTime >= MeasureSeconds)
+		{
+			const uint32 NumCorrections = CharacterMovement->GetNumClientPositionCorrections() - StartCorrections;
+			Test->AddInfo(FString::Printf(
+				TEXT("%u position corrections in %.0f s (%.2f per minute), %d ms round trip, %d%% packet loss"),
+				NumCorrections, RunTime, NumCorrections * 60.0 / RunTime, PacketLagMs * 2, PacketLossPercentage));
+			SetNetworkEmulation(0, 0);
+			return true;
+		}
+
+		// Turn every second, change gait every 2 seconds and roll every 3 seconds
+		const int32 Second = FMath::FloorToInt(RunTime);
+		const FVector Direction = FVector::ForwardVector.RotateAngleAxis(Second * 67.0f, FVector::UpVector);
+		Character->AddMovementInput(Direction, 1.0f);
+
+		if (Second != LastSecond)
+		{
+			LastSecond = Second;
+			if (Second % 2 == 0)
+			{
+				static const EALSGait Gaits[] = {EALSGait::Walking, EALSGait::Running, EALSGait::Sprinting};
+				Character->SetDesiredGait(Gaits[(Second / 2) % UE_ARRAY_COUNT(Gaits)]);
+			}
+			if (Second % 3 == 0 && Character->GetMovementState() == EALSMovementState::Grounded &&
+				Character->GetMovementAction() == EALSMovementAction::None)
+			{
+				Character->Replicated_PlayMontage(Character->GetRollAnimation(), 1.15f);
+			}
+		}
+		return false;
+	}
+
+private:
+	FAutomationTestBase* Test;
+
+	bool bStarted = false;
+
+	uint32 StartCorrections = 0;
+
+	int32 LastSecond = INDEX_NONE;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSNetworkCorrectionBenchmark, "ALS.Network.CorrectionRateBenchmark",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FALSNetworkCorrectionBenchmark::RunTest(const FString& Parameters)
+{
+	FAutomationEditorCommonUtils::LoadMap(ALSAutomationTest::DemoMap);
+	ADD_LATENT_AUTOMATION_COMMAND(FALSStartPIECommand(PIE_ListenServer, 2));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSWaitForClientCharacter(this));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSMeasureClientCorrections(this));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+#endif
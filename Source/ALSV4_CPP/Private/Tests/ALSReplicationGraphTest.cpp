@@ -0,0 +1,220 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#include "Character/ALSBaseCharacter.h"
+#include "Replication/ALSReplicationGraph.h"
+#include "Tests/ALSAutomationTestUtils.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "IpConnection.h"
+#include "IpNetDriver.h"
+#include "SocketSubsystem.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr int32 NumConnections = 100;
+
+	constexpr int32 NumCharacters = 200;
+
+	constexpr float CharacterSpacing = 500.0f;
+
+	constexpr double MeasureSeconds = 30.0;
+
+	/** Base of the fake remote addresses, TEST-NET-1 isn't routed so the packets sent to them go nowhere */
+	constexpr uint32 FakeAddressBase = 0xC0000200;
+
+	UReplicationDriver* CreateALSReplicationGraph(UNetDriver* ForNetDriver, const FURL& URL, UWorld* World)
+	{
+		return NewObject<UALSReplicationGraph>(GetTransientPackage());
+	}
+
+	UIpNetDriver* FindServerNetDriver()
+	{
+		UWorld* ServerWorld = ALSAutomationTest::FindPIEWorld(NM_ListenServer);
+		UIpNetDriver* NetDriver = ServerWorld ? Cast<UIpNetDriver>(ServerWorld->GetNetDriver()) : nullptr;
+		return NetDriver && Cast<UALSReplicationGraph>(NetDriver->GetReplicationDriver()) ? NetDriver : nullptr;
+	}
+}
+
+/** Net drivers created from now on replicate with the ALS replication graph, regardless of the config */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FALSSetReplicationGraphDriver, bool, bEnable);
+
+bool FALSSetReplicationGraphDriver::Update()
+{
+	if (bEnable)
+	{
+		UReplicationDriver::CreateReplicationDriverDelegate().BindStatic(&CreateALSReplicationGraph);
+	}
+	else
+	{
+		UReplicationDriver::CreateReplicationDriverDelegate().Unbind();
+	}
+	return true;
+}
+
+/**
+ * Spawn the characters on the listen server and connect the fake connections, each viewing from one of the characters.
+ * The fake connections never complete a handshake, the server replicates to them as if they were loaded clients.
+ */
+class FALSConnectFakeClients : public IAutomationLatentCommand
+{
+public:
+	FALSConnectFakeClients(FAutomationTestBase* InTest, const TSharedRef<FALSTestCharacterList>& InCharacters)
+		: Test(InTest), Characters(InCharacters)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		UIpNetDriver* NetDriver = FindServerNetDriver();
+		if (!NetDriver)
+		{
+			if (GetCurrentRunTime() > 30.0)
+			{
+				Test->AddError(TEXT("The listen server didn't start with the ALS replication graph within 30 seconds"));
+				return true;
+			}
+			return false;
+		}
+
+		UWorld* World = NetDriver->GetWorld();
+		TArray<AALSBaseCharacter*> SpawnedCharacters;
+		if (!ALSAutomationTest::SpawnCharacters(World, NumCharacters, CharacterSpacing, SpawnedCharacters) ||
+			SpawnedCharacters.Num() < NumConnections)
+		{
+			Test->AddError(TEXT("The game mode of the demo level doesn't spawn ALS characters"));
+			return true;
+		}
+
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		for (int32 Index = 0; Index < NumConnections; ++Index)
+		{
+			TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+			Address->SetIp(FakeAddressBase + Index + 1);
+			Address->SetPort(7777);
+
+			UIpConnection* Connection = NewObject<UIpConnection>(GetTransientPackage(), NetDriver->NetConnectionClass);
+			Connection->InitRemoteConnection(NetDriver, NetDriver->GetSocket(), World->URL, *Address, USOCK_Open);
+			Connection->SetClientLoginState(EClientLoginState::Welcomed);
+
+			// Spread the viewers over the grid so the connections gather different cells
+			AALSBaseCharacter* Viewer = SpawnedCharacters[Index * SpawnedCharacters.Num() / NumConnections];
+			Connection->OwningActor = Viewer;
+			Connection->ViewTarget = Viewer;
+			NetDriver->AddClientConnection(Connection);
+		}
+
+		Characters->Append(SpawnedCharacters);
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+
+	TSharedRef<FALSTestCharacterList> Characters;
+};
+
+/**
+ * Move the characters around and time the server replication. The net driver's own replication is skipped meanwhile,
+ * so that every measured frame replicates the changes of the whole frame.
+ */
+class FALSMeasureServerReplication : public IAutomationLatentCommand
+{
+public:
+	FALSMeasureServerReplication(FAutomationTestBase* InTest, const TSharedRef<FALSTestCharacterList>& InCharacters)
+		: Test(InTest), Characters(InCharacters)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		// The connection failed and reported it
+		if (Characters->Num() == 0)
+		{
+			return true;
+		}
+
+		UIpNetDriver* NetDriver = FindServerNetDriver();
+		if (!NetDriver)
+		{
+			Test->AddError(TEXT("The listen server stopped before the measurement ended"));
+			return true;
+		}
+
+		const double RunTime = GetCurrentRunTime();
+		if (RunTime >= MeasureSeconds)
+		{
+			NetDriver->bSkipServerReplicateActors = false;
+			Test->AddInfo(FString::Printf(
+				TEXT("%d connections, %d characters: %d frames, %.3f ms average, %.3f ms max server replication"),
+				NumConnections, Characters->Num(), NumFrames, NumFrames > 0 ? TotalSeconds * 1000.0 / NumFrames : 0.0,
+				MaxSeconds * 1000.0));
+			return true;
+		}
+
+		// Each character walks in its own direction, turning every second
+		const int32 Second = FMath::FloorToInt(RunTime);
+		for (int32 Index = 0; Index < Characters->Num(); ++Index)
+		{
+			if (AALSBaseCharacter* Character = (*Characters)[Index].Get())
+			{
+				Character->AddMovementInput(
+					FVector::ForwardVector.RotateAngleAxis((Index + Second) * 67.0f, FVector::UpVector), 1.0f);
+			}
+		}
+
+		NetDriver->bSkipServerReplicateActors = true;
+		const double StartTime = FPlatformTime::Seconds();
+		NetDriver->GetReplicationDriver()->ServerReplicateActors(NetDriver->GetWorld()->GetDeltaSeconds());
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		TotalSeconds += Seconds;
+		MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+		++NumFrames;
+		return false;
+	}
+
+private:
+	FAutomationTestBase* Test;
+
+	TSharedRef<FALSTestCharacterList> Characters;
+
+	double TotalSeconds = 0.0;
+
+	double MaxSeconds = 0.0;
+
+	int32 NumFrames = 0;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSReplicationGraphSoakTest, "ALS.Network.ReplicationGraphSoak",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FALSReplicationGraphSoakTest::RunTest(const FString& Parameters)
+{
+	// Shared by the latent commands, they run after this returns
+	const TSharedRef<FALSTestCharacterList> Characters = MakeShared<FALSTestCharacterList>();
+
+	FAutomationEditorCommonUtils::LoadMap(ALSAutomationTest::DemoMap);
+	ADD_LATENT_AUTOMATION_COMMAND(FALSSetReplicationGraphDriver(true));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSStartPIECommand(PIE_ListenServer, 1));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSConnectFakeClients(this, Characters));
+	ADD_LATENT_AUTOMATION_COMMAND(FALSMeasureServerReplication(this, Characters));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	ADD_LATENT_AUTOMATION_COMMAND(FALSSetReplicationGraphDriver(false));
+	return true;
+}
+
+#endif
@@ -24,12 +24,90 @@ class UAnimInstance;
 class UAnimMontage;
 class UALSCharacterAnimInstance;
 class UALSPlayerCameraBehavior;
+class UNetConnection;
+class AALSBaseCharacter;
 enum class EVisibilityBasedAnimTickOption : uint8;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FJumpPressedSignature);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRagdollStateChangedSignature, bool, bRagdollState);
 
+/**
+ * Locomotion state replicated to simulated proxies as one property: bit packed enums, acceleration quantized to
+ * the character's AccelerationQuantizationLevel and control rotation compressed to short angles. Acceleration and
+ * control rotation are left out for viewers on reduced rate replication tiers of the owner, and sent again once the
+ * tier's interval elapsed.
+ */
+USTRUCT()
+struct FALSReplicatedLocomotion
+{
+	GENERATED_BODY()
+
+	/** Decides per connection whether acceleration and control rotation are sent, set on the server */
+	TWeakObjectPtr<AALSBaseCharacter> Owner;
+
+	/** Whether the last received update contained acceleration and control rotation */
+	bool bHasLocomotionData = true;
+
+	UPROPERTY()
+	FVector Acceleration = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator ControlRotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	EVectorQuantization AccelerationQuantizationLevel = EVectorQuantization::RoundWholeNumber;
+
+	UPROPERTY()
+	EALSGait DesiredGait = EALSGait::Running;
+
+	UPROPERTY()
+	EALSStance DesiredStance = EALSStance::Standing;
+
+	UPROPERTY()
+	EALSRotationMode DesiredRotationMode = EALSRotationMode::LookingDirection;
+
+	UPROPERTY()
+	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
+
+	UPROPERTY()
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+
+	UPROPERTY()
+	EALSViewMode ViewMode = EALSViewMode::ThirdPerson;
+
+	/**
+	 * Changed on the server to replicate the current values again, to the connections that missed them on a reduced
+	 * rate tier. Only compared, never serialized.
+	 */
+	UPROPERTY()
+	uint8 ResendSequence = 0;
+
+	/** Round the values to what is sent, so that changes below the precision do not trigger replication */
+	void Quantize();
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+/** Acceleration and control rotation replication of a character to one connection on a reduced rate tier */
+struct FALSLocomotionSendState
+{
+	/** Acceleration and control rotation are throttled for this connection until then */
+	float NextSendTime = 0.0f;
+
+	/** Whether the connection missed the latest acceleration and control rotation */
+	bool bPendingResend = false;
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSReplicatedLocomotion> : public TStructOpsTypeTraitsBase2<FALSReplicatedLocomotion>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
 /*
  * Base character class
  */
@@ -38,6 +116,8 @@ class ALSV4_CPP_API AALSBaseCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
+	friend class UALSLocomotionSubsystem;
+
 public:
 	AALSBaseCharacter(const FObjectInitializer& ObjectInitializer);
 
@@ -51,6 +131,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PreInitializeComponents() override;
 
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
@@ -59,6 +141,14 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/** Whether acceleration and control rotation should be sent to this connection, based on the replication tiers */
+	bool ShouldSendLocomotionData(UNetConnection* Connection);
+
+	/** Locomotion replication tier of the connection's view target, null for replays and without tiers */
+	const FALSLocomotionReplicationTier* FindLocomotionReplicationTier(const UNetConnection* Connection) const;
+
 	/** Ragdoll System */
 
 	/** Implement on BP to get required get up animation according to character's state */
@@ -188,24 +278,15 @@ public:
 	UFUNCTION(BlueprintSetter, Category = "ALS|Input")
 	void SetDesiredStance(EALSStance NewStance);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Input")
-	void Server_SetDesiredStance(EALSStance NewStance);
-
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void SetDesiredGait(EALSGait NewGait);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_SetDesiredGait(EALSGait NewGait);
-
 	UFUNCTION(BlueprintGetter, Category = "ALS|Input")
 	EALSRotationMode GetDesiredRotationMode() const { return DesiredRotationMode; }
 
 	UFUNCTION(BlueprintSetter, Category = "ALS|Input")
 	void SetDesiredRotationMode(EALSRotationMode NewRotMode);
 
-	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Character States")
-	void Server_SetDesiredRotationMode(EALSRotationMode NewRotMode);
-
 	UFUNCTION(BlueprintCallable, Category = "ALS|Input")
 	FVector GetPlayerMovementInput() const;
 
@@ -326,6 +407,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Essential Information")
 	void GetControlForwardRightVector(FVector& Forward, FVector& Right) const;
 
+	/** Footstep System */
+
+	UFUNCTION(BlueprintGetter, Category = "ALS|Footstep System")
+	EALSFootstepTraceMode GetFootstepTraceMode() const { return FootstepTraceMode; }
+
+	UFUNCTION(BlueprintGetter, Category = "ALS|Footstep System")
+	bool ShouldSkipFootstepTraceOnDedicatedServer() const { return bSkipFootstepTraceOnDedicatedServer; }
+
 protected:
 	/** Ragdoll System */
 
@@ -365,6 +454,8 @@ protected:
 
 	void SetEssentialValues(float DeltaTime);
 
+	void UpdateReplicatedEssentialValues();
+
 	void UpdateCharacterMovement();
 
 	void UpdateGroundedRotation(float DeltaTime);
@@ -421,13 +512,7 @@ protected:
 
 	/** Replication */
 	UFUNCTION(Category = "ALS|Replication")
-	void OnRep_RotationMode(EALSRotationMode PrevRotMode);
-
-	UFUNCTION(Category = "ALS|Replication")
-	void OnRep_ViewMode(EALSViewMode PrevViewMode);
-
-	UFUNCTION(Category = "ALS|Replication")
-	void OnRep_OverlayState(EALSOverlayState PrevOverlayState);
+	void OnRep_ReplicatedLocomotion();
 
 	UFUNCTION(Category = "ALS|Replication")
 	void OnRep_VisibleMesh(USkeletalMesh* NewVisibleMesh);
@@ -439,13 +524,13 @@ protected:
 
 	/** Input */
 
-	UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "ALS|Input")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
 	EALSRotationMode DesiredRotationMode = EALSRotationMode::LookingDirection;
 
-	UPROPERTY(EditAnywhere, Replicated, BlueprintReadWrite, Category = "ALS|Input")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
 	EALSGait DesiredGait = EALSGait::Running;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "ALS|Input")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input")
 	EALSStance DesiredStance = EALSStance::Standing;
 
 	UPROPERTY(EditDefaultsOnly, Category = "ALS|Input", BlueprintReadOnly)
@@ -482,7 +567,7 @@ protected:
 
 	/** State Values */
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_OverlayState)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values")
 	EALSOverlayState OverlayState = EALSOverlayState::Default;
 
 	/** Movement System */
@@ -490,6 +575,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Movement System")
 	FDataTableRowHandle MovementModel;
 
+	/** Let the locomotion subsystem update the essential values of this character together with all others */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Movement System")
+	bool bUseBatchedLocomotion = false;
+
 	/** Essential Information */
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
@@ -521,12 +610,27 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
 	float EasedMaxAcceleration = 0.0f;
 
-	UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Essential Information")
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
 	FVector ReplicatedCurrentAcceleration = FVector::ZeroVector;
 
-	UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Essential Information")
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
 	FRotator ReplicatedControlRotation = FRotator::ZeroRotator;
 
+	/** Precision of the acceleration replicated to simulated proxies */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Replication")
+	EVectorQuantization AccelerationQuantizationLevel = EVectorQuantization::RoundWholeNumber;
+
+	/** Replicated acceleration, control rotation, desired inputs and state values, packed in PreReplication */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedLocomotion)
+	FALSReplicatedLocomotion ReplicatedLocomotion;
+
+	/**
+	 * Distance tiers reducing how often acceleration and control rotation are sent to far viewers, sorted by
+	 * ascending distance. Simulated proxies derive them from the replicated movement while they are stale.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Replication")
+	TArray<FALSLocomotionReplicationTier> LocomotionReplicationTiers;
+
 	/** Replicated Skeletal Mesh Information*/
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Skeletal Mesh", ReplicatedUsing = OnRep_VisibleMesh)
 	USkeletalMesh* VisibleMesh = nullptr;
@@ -542,7 +646,7 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
 	EALSMovementAction MovementAction = EALSMovementAction::None;
 
-	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_RotationMode)
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
 	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|State Values")
@@ -551,7 +655,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values")
 	EALSStance Stance = EALSStance::Standing;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_ViewMode)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|State Values")
 	EALSViewMode ViewMode = EALSViewMode::ThirdPerson;
 
 	/** Movement System */
@@ -608,6 +712,26 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Ragdoll System")
 	FVector TargetRagdollLocation = FVector::ZeroVector;
 
+	/** Footstep System */
+
+	/** Hit FX tables used by this character's footstep notifies, streamed in on begin play to avoid loads on first step */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Footstep System")
+	TArray<UDataTable*> FootstepHitDataTables;
+
+	/** Asynchronous footstep traces are batched by the footstep subsystem, their FX spawn on the next frame */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Footstep System")
+	EALSFootstepTraceMode FootstepTraceMode = EALSFootstepTraceMode::Synchronous;
+
+	/** Enable for characters with audio only footsteps, there is nothing to play on a dedicated server */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Footstep System")
+	bool bSkipFootstepTraceOnDedicatedServer = false;
+
+	/** Significance */
+
+	/** Let the significance subsystem lower this character's tick rates while it is far away or not rendered */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	bool bUseSignificance = false;
+
 	/* Server ragdoll pull force storage*/
 	float ServerRagdollPull = 0.0f;
 
@@ -620,6 +744,12 @@ protected:
 
 	float PreviousAimYaw = 0.0f;
 
+	/** Essential values are updated by the locomotion subsystem before this character ticks */
+	bool bEssentialValuesBatched = false;
+
+	/** Acceleration and control rotation replication to each connection on a reduced rate tier */
+	TMap<TWeakObjectPtr<UNetConnection>, FALSLocomotionSendState> LocomotionSendStates;
+
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Utility")
 	UALSCharacterAnimInstance* MainAnimInstance = nullptr;
 
@@ -641,7 +771,7 @@ protected:
 	/* Smooth out aiming by interping control rotation*/
 	FRotator AimingRotation = FRotator::ZeroRotator;
 
-	/** We won't use curve based movement and a few other features on networked games */
+	/** Rolling rotation runs in the character tick and isn't replayed with the moves, so it's off in networked games */
 	bool bEnableNetworkOptimizations = false;
 
 private:
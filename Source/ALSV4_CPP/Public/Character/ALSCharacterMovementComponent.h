@@ -9,10 +9,35 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Library/ALSBakedCurve.h"
 #include "Library/ALSCharacterStructLibrary.h"
 
 #include "ALSCharacterMovementComponent.generated.h"
 
+/** Move data carrying the locomotion inputs of the owning client, so they are applied in order with the moves */
+class ALSV4_CPP_API FALSCharacterNetworkMoveData : public FCharacterNetworkMoveData
+{
+public:
+	typedef FCharacterNetworkMoveData Super;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap,
+	                       ENetworkMoveType MoveType) override;
+
+	EALSGait AllowedGait = EALSGait::Walking;
+	EALSGait DesiredGait = EALSGait::Running;
+	EALSStance DesiredStance = EALSStance::Standing;
+	EALSRotationMode DesiredRotationMode = EALSRotationMode::LookingDirection;
+};
+
+class ALSV4_CPP_API FALSCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+public:
+	FALSCharacterNetworkMoveDataContainer();
+
+	FALSCharacterNetworkMoveData ALSDefaultMoveData[3];
+};
+
 /**
  * Authoritative networked Character Movement
  */
@@ -29,6 +54,8 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 
 		virtual void Clear() override;
 		virtual uint8 GetCompressedFlags() const override;
+		virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter,
+		                            float MaxDelta) const override;
 		virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel,
 		                        class FNetworkPredictionData_Client_Character& ClientData) override;
 		virtual void PrepMoveFor(class ACharacter* Character) override;
@@ -36,6 +63,11 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 		// Walk Speed Update
 		uint8 bSavedRequestMovementSettingsChange : 1;
 		EALSGait SavedAllowedGait = EALSGait::Walking;
+
+		// Locomotion Input
+		EALSGait SavedDesiredGait = EALSGait::Running;
+		EALSStance SavedDesiredStance = EALSStance::Standing;
+		EALSRotationMode SavedDesiredRotationMode = EALSRotationMode::LookingDirection;
 	};
 
 	class FNetworkPredictionData_Client_My : public FNetworkPredictionData_Client_Character
@@ -51,6 +83,12 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
 	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 	virtual void OnMovementUpdated(float DeltaTime, const FVector& OldLocation, const FVector& OldVelocity) override;
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+	                            const FVector& NewAccel) override;
+	virtual void ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc, FVector NewVel,
+	                                                 UPrimitiveComponent* NewBase, FName NewBaseBoneName,
+	                                                 bool bHasBase, bool bBaseRelativePosition,
+	                                                 uint8 ServerMovementMode) override;
 
 	// Movement Settings Override
 	virtual void PhysWalking(float deltaTime, int32 Iterations) override;
@@ -70,6 +108,9 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 	// Set Movement Curve (Called in every instance)
 	float GetMappedSpeed() const;
 
+	/** Rotation Rate Curve of the current movement settings, evaluated from its baked samples */
+	float GetMappedRotationRate(float MappedSpeed) const;
+
 	UFUNCTION(BlueprintCallable, Category = "Movement Settings")
 	void SetMovementSettings(FALSMovementSettings NewMovementSettings);
 
@@ -77,6 +118,16 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 	UFUNCTION(BlueprintCallable, Category = "Movement Settings")
 	void SetAllowedGait(EALSGait NewAllowedGait);
 
-	UFUNCTION(Reliable, Server, Category = "Movement Settings")
-	void Server_SetAllowedGait(EALSGait NewAllowedGait);
+	/** Position corrections received by the owning client since the component was created */
+	uint32 GetNumClientPositionCorrections() const { return NumClientPositionCorrections; }
+
+private:
+	FALSCharacterNetworkMoveDataContainer ALSMoveDataContainer;
+
+	/** Curves of the current movement settings, baked so that client and server sample them identically */
+	TSharedPtr<const FALSBakedCurve> MovementCurveSamples;
+
+	TSharedPtr<const FALSBakedCurve> RotationRateCurveSamples;
+
+	uint32 NumClientPositionCorrections = 0;
 };
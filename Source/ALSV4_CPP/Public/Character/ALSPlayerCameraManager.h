@@ -9,15 +9,40 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Animation/SmartName.h"
 #include "Camera/PlayerCameraManager.h"
+#include "Library/ALSCharacterStructLibrary.h"
+#include "WorldCollision.h"
 #include "ALSPlayerCameraManager.generated.h"
 
 // forward declarations
 class UALSDebugComponent;
 class AALSBaseCharacter;
+class UALSCameraBehaviorAsset;
+class USkeleton;
+
+/** Camera behavior curves read by the camera manager */
+enum class EALSCameraCurve : uint8
+{
+	RotationLagSpeed,
+	Override_Debug,
+	PivotLagSpeed_X,
+	PivotLagSpeed_Y,
+	PivotLagSpeed_Z,
+	PivotOffset_X,
+	PivotOffset_Y,
+	PivotOffset_Z,
+	CameraOffset_X,
+	CameraOffset_Y,
+	CameraOffset_Z,
+	Weight_FirstPerson,
+	MAX
+};
 
 /**
- * Player camera manager class
+ * Player camera manager class. Camera behavior parameters come from the curves of the CameraBehavior anim instance,
+ * or from CameraBehaviorAsset when it is set. Subclasses using the asset can skip creating the CameraBehavior
+ * component with DoNotCreateDefaultSubobject.
  */
 UCLASS(Blueprintable, BlueprintType)
 class ALSV4_CPP_API AALSPlayerCameraManager : public APlayerCameraManager
@@ -25,7 +50,7 @@ class ALSV4_CPP_API AALSPlayerCameraManager : public APlayerCameraManager
 	GENERATED_BODY()
 
 public:
-	AALSPlayerCameraManager();
+	AALSPlayerCameraManager(const FObjectInitializer& ObjectInitializer);
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
 	void OnPossess(AALSBaseCharacter* NewCharacter);
@@ -38,6 +63,8 @@ public:
 	void DrawDebugTargets(FVector PivotTargetLocation);
 
 protected:
+	virtual void BeginPlay() override;
+
 	virtual void UpdateViewTargetInternal(FTViewTarget& OutVT, float DeltaTime) override;
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
@@ -47,6 +74,23 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
 	bool CustomCameraBehavior(float DeltaTime, FVector& Location, FRotator& Rotation, float& FOV);
 
+	/** Read all camera behavior curves of this frame in one pass */
+	void UpdateCameraCurveValues(float DeltaTime);
+
+	/** Resolve the camera behavior curve UIDs, once per camera behavior skeleton */
+	void ResolveCameraCurveUIDs(const UAnimInstance* AnimInstance);
+
+	/** Evaluate the camera behavior curves from CameraBehaviorAsset without the anim graph */
+	void EvaluateCameraBehaviorAsset(float DeltaTime);
+
+	float GetCachedCameraParam(EALSCameraCurve Curve) const
+	{
+		return CameraCurveValues[static_cast<int32>(Curve)];
+	}
+
+	/** Sweep from the trace origin to the target camera location, returns the corrective offset of the camera */
+	FVector TraceCameraCollision(const FVector& TraceOrigin, float TraceRadius, ECollisionChannel TraceChannel);
+
 public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "ALS|Camera")
 	AALSBaseCharacter* ControlledCharacter = nullptr;
@@ -54,6 +98,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "ALS|Camera")
 	USkeletalMeshComponent* CameraBehavior = nullptr;
 
+	/** Use these parameters instead of the CameraBehavior anim graph, the CameraBehavior component stops ticking */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera")
+	UALSCameraBehaviorAsset* CameraBehaviorAsset = nullptr;
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
 	FVector RootLocation;
@@ -76,6 +124,48 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera")
 	FVector DebugViewOffset;
 
+	/** Use last frame's result of an async sweep for the camera collision, a sync sweep is used until one arrives */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera")
+	bool bUseAsyncCameraTrace = false;
+
+	/** Reuse the last camera collision result while the trace origin and camera moved less than this, 0 disables */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera", meta = (ClampMin = 0))
+	float CameraTraceReuseDistance = 0.0f;
+
+	/** Maximum age of a reused camera collision result, so that objects moving into the view are still caught */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Camera", meta = (ClampMin = 0))
+	float CameraTraceReuseMaxAge = 0.1f;
+
 private:
 	UALSDebugComponent* DebugComponent = nullptr;
+
+	/** Camera behavior curve values of the current frame, indexed by EALSCameraCurve */
+	float CameraCurveValues[static_cast<int32>(EALSCameraCurve::MAX)] = {};
+
+	/** Smart name UIDs of the camera behavior curves in CameraCurveSkeleton, indexed by EALSCameraCurve */
+	SmartName::UID_Type CameraCurveUIDs[static_cast<int32>(EALSCameraCurve::MAX)];
+
+	/** Skeleton of the camera behavior anim instance the curve UIDs were resolved for */
+	TWeakObjectPtr<const USkeleton> CameraCurveSkeleton;
+
+	/** Blended parameters of CameraBehaviorAsset */
+	FALSCameraBehaviorParams CurrentBehaviorParams;
+
+	float CurrentFirstPersonWeight = 0.0f;
+
+	bool bHasBehaviorParams = false;
+
+	FTraceHandle CameraTraceHandle;
+
+	bool bHasCameraTraceResult = false;
+
+	FVector LastCameraTraceOrigin = FVector::ZeroVector;
+
+	FVector LastCameraTraceEnd = FVector::ZeroVector;
+
+	float LastCameraTraceRadius = 0.0f;
+
+	FVector LastCameraTraceOffset = FVector::ZeroVector;
+
+	float LastCameraTraceTime = 0.0f;
 };
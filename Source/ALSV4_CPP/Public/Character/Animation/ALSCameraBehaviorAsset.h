@@ -0,0 +1,69 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+#include "ALSCameraBehaviorAsset.generated.h"
+
+/**
+ * Camera behavior parameters keyed on the character state, used by the camera manager instead of the camera behavior
+ * anim graph when set. The first person and movement state parameters take precedence in that order when enabled,
+ * the third person parameters of the rotation mode, stance and gait are used otherwise.
+ */
+UCLASS(BlueprintType)
+class ALSV4_CPP_API UALSCameraBehaviorAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
+	FALSCameraBehaviorParams GetParams(EALSViewMode ViewMode, EALSMovementState MovementState,
+	                                   EALSRotationMode RotationMode, EALSStance Stance, EALSGait Gait) const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
+	FALSCameraBehaviorStateParams ThirdPerson;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
+	bool bUseFirstPersonParams = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera", meta = (EditCondition =
+		"bUseFirstPersonParams"))
+	FALSCameraBehaviorParams FirstPerson;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
+	bool bUseInAirParams = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera", meta = (EditCondition = "bUseInAirParams"))
+	FALSCameraBehaviorParams InAir;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
+	bool bUseMantlingParams = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera", meta = (EditCondition =
+		"bUseMantlingParams"))
+	FALSCameraBehaviorParams Mantling;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
+	bool bUseRagdollParams = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera", meta = (EditCondition = "bUseRagdollParams"))
+	FALSCameraBehaviorParams Ragdoll;
+
+	/** Blend speed between the parameters of two states */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
+	float BlendSpeed = 8.0f;
+
+	/** Blend speed between the third and first person view modes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Camera")
+	float ViewModeBlendSpeed = 10.0f;
+};
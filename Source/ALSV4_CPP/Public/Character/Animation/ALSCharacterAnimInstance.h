@@ -10,6 +10,8 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "WorldCollision.h"
 #include "Library/ALSAnimationStructLibrary.h"
 #include "Library/ALSStructEnumLibrary.h"
 
@@ -22,6 +24,167 @@ class UCurveFloat;
 class UAnimSequence;
 class UCurveVector;
 
+/** ALS anim curves, read once per update into UALSCharacterAnimInstance's curve cache */
+enum class EALSAnimCurve : uint8
+{
+	BasePose_CLF,
+	BasePose_N,
+	Enable_FootIK_L,
+	Enable_FootIK_R,
+	Enable_HandIK_L,
+	Enable_HandIK_R,
+	Enable_Transition,
+	FootLock_L,
+	FootLock_R,
+	Layering_Arm_L,
+	Layering_Arm_L_Add,
+	Layering_Arm_L_LS,
+	Layering_Arm_R,
+	Layering_Arm_R_Add,
+	Layering_Arm_R_LS,
+	Layering_Hand_L,
+	Layering_Hand_R,
+	Layering_Head_Add,
+	Layering_Spine_Add,
+	Mask_AimOffset,
+	Mask_LandPrediction,
+	RotationAmount,
+	W_Gait,
+	MAX
+};
+
+/** Game thread data the animation values update reads, gathered before the update possibly runs on a worker thread */
+struct FALSAnimUpdateSnapshot
+{
+	float DeltaSeconds = 0.0f;
+
+	float MaxAcceleration = 0.0f;
+
+	float MaxBrakingDeceleration = 0.0f;
+
+	float MeshScaleZ = 1.0f;
+
+	float RagdollSpeed = 0.0f;
+};
+
+/**
+ * Character state set on the game thread. Copied to the anim instance before every update, so the update and the anim
+ * graph never read members the game thread writes while they possibly run on a worker thread.
+ */
+struct FALSAnimCharacterState
+{
+	FALSAnimCharacterInformation CharacterInformation;
+
+	EALSMovementState MovementState = EALSMovementState::None;
+
+	EALSMovementAction MovementAction = EALSMovementAction::None;
+
+	EALSRotationMode RotationMode = EALSRotationMode::LookingDirection;
+
+	EALSGait Gait = EALSGait::Walking;
+
+	EALSStance Stance = EALSStance::Standing;
+
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+
+	bool bJumped = false;
+
+	float JumpPlayRate = 1.2f;
+};
+
+/** Inputs of the movement values update, gathered on the game thread */
+struct FALSAnimMovementInput
+{
+	float DeltaSeconds = 0.0f;
+
+	FVector Velocity = FVector::ZeroVector;
+
+	FVector Acceleration = FVector::ZeroVector;
+
+	FQuat ActorQuat = FQuat::Identity;
+
+	FRotator AimingRotation = FRotator::ZeroRotator;
+
+	float Speed = 0.0f;
+
+	float MaxAcceleration = 0.0f;
+
+	float MaxBrakingDeceleration = 0.0f;
+
+	float MeshScaleZ = 1.0f;
+
+	float FallSpeed = 0.0f;
+
+	float GaitCurve = 0.0f;
+
+	float BasePoseCLFCurve = 0.0f;
+
+	EALSGait Gait = EALSGait::Walking;
+
+	EALSRotationMode RotationMode = EALSRotationMode::VelocityDirection;
+
+	/** Grounded and moving, otherwise in air */
+	bool bGrounded = true;
+
+	bool bUpdateLean = true;
+};
+
+/** Values written by the movement values update, the previous values are its interpolation state */
+struct FALSAnimMovementValues
+{
+	FALSVelocityBlend VelocityBlend;
+
+	FALSLeanAmount LeanAmount;
+
+	FVector RelativeAccelerationAmount = FVector::ZeroVector;
+
+	EALSMovementDirection MovementDirection = EALSMovementDirection::Forward;
+
+	float DiagonalScaleAmount = 0.0f;
+
+	float WalkRunBlend = 0.0f;
+
+	float StrideBlend = 0.0f;
+
+	float StandingPlayRate = 1.0f;
+
+	float CrouchingPlayRate = 1.0f;
+
+	float FYaw = 0.0f;
+
+	float BYaw = 0.0f;
+
+	float LYaw = 0.0f;
+
+	float RYaw = 0.0f;
+};
+
+/**
+ * Anim instance proxy running the ALS animation values update, on a worker thread
+ * if the anim blueprint uses multi-threaded animation update
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FALSAnimInstanceProxy()
+	{
+	}
+
+	FALSAnimInstanceProxy(UAnimInstance* InAnimInstance)
+		: FAnimInstanceProxy(InAnimInstance)
+	{
+	}
+
+protected:
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+
+	virtual void Update(float DeltaSeconds) override;
+
+	virtual void PostUpdate(UAnimInstance* InAnimInstance) const override;
+};
+
 /**
  * Main anim instance class for character
  */
@@ -30,11 +193,18 @@ class ALSV4_CPP_API UALSCharacterAnimInstance : public UAnimInstance
 {
 	GENERATED_BODY()
 
+	friend struct FALSAnimInstanceProxy;
+	friend class UALSAnimationSubsystem;
+	friend class FALSVelocityBlendTest;
+	friend class FALSRelativeAccelerationTest;
+
 public:
 	virtual void NativeInitializeAnimation() override;
 
 	virtual void NativeBeginPlay() override;
 
+	virtual void NativeUninitializeAnimation() override;
+
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Animation")
@@ -94,12 +264,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Grounded")
 	bool CanDynamicTransition() const;
 
+	/** Move the instance in or out of the animation subsystem's batched update */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Threading")
+	void SetUseBatchedUpdate(bool bEnable);
+
+	/** Issue the foot IK and land prediction traces asynchronously, see FALSAnimConfiguration */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Threading")
+	void SetUseAsyncGroundTraces(bool bEnable)
+	{
+		Config.bUseAsyncGroundTraces = bEnable;
+	}
+
 	/** Return mutable reference of character information to edit them easily inside character class */
 	FALSAnimCharacterInformation& GetCharacterInformationMutable()
 	{
-		return CharacterInformation;
+		return CharacterState.CharacterInformation;
+	}
+
+	/** Character state the next update picks up, set it instead of the anim instance members on the game thread */
+	FALSAnimCharacterState& GetCharacterStateMutable()
+	{
+		return CharacterState;
 	}
 
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
 private:
 	void PlayDynamicTransitionDelay();
 
@@ -107,6 +299,25 @@ private:
 
 	void OnPivotDelay();
 
+	/** Anim LOD */
+
+	void UpdateLODTier();
+
+	float GetLODMetricValue() const;
+
+	const FALSAnimLODTier& GetCurrentLODTier() const;
+
+	/**
+	 * Game thread part of the update: reads the character information and snapshot, picks the LOD tier and reduced
+	 * rate frame and reads the anim curves the update needs. Runs once per frame before the update.
+	 */
+	void GatherCharacterInformation(float DeltaSeconds);
+
+	/** Thread safe part of the update, only reads the gathered character information and snapshot */
+	void UpdateAnimationValues(float DeltaSeconds);
+
+	void PlayPendingTurnInPlace();
+
 	/** Update Values */
 
 	void UpdateAimingValues(float DeltaSeconds);
@@ -115,17 +326,27 @@ private:
 
 	void UpdateFootIK(float DeltaSeconds);
 
+	/** Velocity blend, lean, stride blend, play rates and yaw offsets while moving on the ground or in air */
 	void UpdateMovementValues(float DeltaSeconds);
 
-	void UpdateRotationValues();
+	/** Gather the batched movement values update input, returns false if the update has nothing to compute */
+	bool GatherMovementInput(float DeltaSeconds, FALSAnimMovementInput& Input) const;
 
-	void UpdateInAirValues(float DeltaSeconds);
+	void GatherMovementValues(FALSAnimMovementValues& Values) const;
+
+	void ApplyMovementValues(const FALSAnimMovementValues& Values);
+
+	/** Pure math part of the movement values update, only reads the configuration and blend curves of this instance */
+	void CalculateMovementValues(const FALSAnimMovementInput& Input, FALSAnimMovementValues& Values) const;
+
+	/** Write the result of the batched movement values update, which replaces the update of this frame */
+	void ApplyBatchedMovementValues(const FALSAnimMovementValues& Values);
 
 	void UpdateRagdollValues();
 
 	/** Foot IK */
 
-	void SetFootLocking(float DeltaSeconds, FName EnableFootIKCurve, FName FootLockCurve, FName IKFootBone,
+	void SetFootLocking(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve, EALSAnimCurve FootLockCurve, FName IKFootBone,
                           float& CurFootLockAlpha, bool& UseFootLockCurve,
                           FVector& CurFootLockLoc, FRotator& CurFootLockRot);
 
@@ -135,8 +356,13 @@ private:
 
 	void ResetIKOffsets(float DeltaSeconds);
 
-	void SetFootOffsets(float DeltaSeconds, FName EnableFootIKCurve, FName IKFootBone, FName RootBone,
-                          FVector& CurLocationTarget, FVector& CurLocationOffset, FRotator& CurRotationOffset);
+	void SetFootOffsets(float DeltaSeconds, EALSAnimCurve EnableFootIKCurve, FName IKFootBone, FName RootBone,
+                          FVector& CurLocationTarget, FVector& CurLocationOffset, FRotator& CurRotationOffset,
+                          FTraceHandle& TraceHandle);
+
+	/** Traces for the ground, using last frame's async result when async ground traces are enabled */
+	bool TraceGround(FTraceHandle& TraceHandle, const FVector& Start, const FVector& End, const FCollisionShape& Shape,
+	                 FHitResult& OutHit);
 
 	/** Grounded */
 
@@ -146,33 +372,41 @@ private:
 
 	void DynamicTransitionCheck();
 
-	FALSVelocityBlend CalculateVelocityBlend() const;
+	/** Target velocity blend as an F, B, L, R vector */
+	static VectorRegister CalculateVelocityBlend(const FALSAnimMovementInput& Input);
 
 	void TurnInPlace(FRotator TargetRotation, float PlayRateScale, float StartTime, bool OverrideCurrent);
 
 	/** Movement */
 
-	FVector CalculateRelativeAccelerationAmount() const;
+	static FVector CalculateRelativeAccelerationAmount(const FALSAnimMovementInput& Input);
 
-	float CalculateStrideBlend() const;
+	float CalculateStrideBlend(const FALSAnimMovementInput& Input) const;
 
-	float CalculateWalkRunBlend() const;
+	static float CalculateWalkRunBlend(const FALSAnimMovementInput& Input);
 
-	float CalculateStandingPlayRate() const;
+	float CalculateStandingPlayRate(const FALSAnimMovementInput& Input, float StrideBlend) const;
 
-	float CalculateDiagonalScaleAmount() const;
+	float CalculateDiagonalScaleAmount(const FALSVelocityBlend& CurrentVelocityBlend) const;
 
-	float CalculateCrouchingPlayRate() const;
+	float CalculateCrouchingPlayRate(const FALSAnimMovementInput& Input, float StrideBlend) const;
 
-	float CalculateLandPrediction() const;
+	float CalculateLandPrediction();
 
-	FALSLeanAmount CalculateAirLeanAmount() const;
+	FALSLeanAmount CalculateAirLeanAmount(const FALSAnimMovementInput& Input) const;
 
-	EALSMovementDirection CalculateMovementDirection() const;
+	static EALSMovementDirection CalculateMovementDirection(const FALSAnimMovementInput& Input,
+	                                                        EALSMovementDirection CurrentMovementDirection);
 
 	/** Util */
 
-	float GetAnimCurveClamped(const FName& Name, float Bias, float ClampMin, float ClampMax) const;
+	float GetCachedCurveValue(EALSAnimCurve Curve) const
+	{
+		return CurveValues[static_cast<int32>(Curve)];
+	}
+
+	/** Read the ALS curves the update needs this frame, depends on the movement state, LOD tier and reduced rate frame */
+	void UpdateCurveValues();
 
 protected:
 	/** References */
@@ -270,6 +504,31 @@ protected:
 		ShowOnlyInnerProperties))
 	FALSAnimConfiguration Config;
 
+	/** Anim LOD */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Anim LOD")
+	EALSAnimLODMetric LODMetric = EALSAnimLODMetric::Distance;
+
+	/** Tiers sorted by ascending threshold. Everything updates every frame until the first tier is reached */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Anim LOD")
+	TArray<FALSAnimLODTier> LODTiers;
+
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Read Only Data|Anim LOD")
+	int32 CurrentLODTier = INDEX_NONE;
+
+	/**
+	 * Run the animation values update from the anim instance proxy, which moves it to a worker thread when the
+	 * anim blueprint uses multi-threaded animation update. Traces, socket reads and montages stay on the game thread.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Threading")
+	bool bUseThreadSafeUpdate = false;
+
+	/**
+	 * Compute the movement values of all batched instances in parallel in the animation subsystem, before the
+	 * skeletal meshes tick. Uses the world delta time, so it does not follow animation update rate optimizations.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Threading")
+	bool bUseBatchedUpdate = false;
+
 	/** Blend Curves */
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Configuration|Blend Curves")
@@ -320,5 +579,42 @@ private:
 
 	bool bCanPlayDynamicTransition = true;
 
+	/** Frame time and count skipped by the reduced rate features of the current LOD tier */
+	float SkippedDeltaSeconds = 0.0f;
+
+	int32 SkippedFrameCount = 0;
+
+	bool bReducedRateFrame = true;
+
+	float ReducedRateDeltaSeconds = 0.0f;
+
+	FALSAnimCharacterState CharacterState;
+
+	/** Frame the character information and curves were last gathered in */
+	uint64 GatheredFrame = 0;
+
+	FALSAnimUpdateSnapshot UpdateSnapshot;
+
+	bool bAnimationValuesPending = false;
+
+	bool bTurnInPlacePending = false;
+
+	/** Frame the animation subsystem last computed the movement values of this instance in */
+	uint64 BatchedMovementValuesFrame = 0;
+
+	FRotator PendingTurnInPlaceRotation = FRotator::ZeroRotator;
+
+	FTraceHandle FootTraceHandle_L;
+
+	FTraceHandle FootTraceHandle_R;
+
+	FTraceHandle LandPredictionTraceHandle;
+
+	/** ALS curve values of the current update, indexed by EALSAnimCurve. Curves the update skips keep old values */
+	float CurveValues[static_cast<int32>(EALSAnimCurve::MAX)] = {};
+
+	/** Skeleton curve UIDs of the ALS curves, resolved when the animation is initialized */
+	SmartName::UID_Type CurveUIDs[static_cast<int32>(EALSAnimCurve::MAX)];
+
 	UALSDebugComponent* DebugComponent = nullptr;
 };
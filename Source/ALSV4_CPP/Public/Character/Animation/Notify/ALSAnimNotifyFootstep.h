@@ -30,6 +30,10 @@ class ALSV4_CPP_API UALSAnimNotifyFootstep : public UAnimNotify
 	virtual FString GetNotifyName_Implementation() const override;
 
 public:
+	/** Spawn the sound, niagara and decal effects of the surface hit by the footstep trace */
+	void SpawnFootstepFX(USkeletalMeshComponent* MeshComp, const FHitResult& Hit, const FRotator& FootRotation,
+	                     float MaskCurveValue) const;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
 	UDataTable* HitDataTable;
 
@@ -11,12 +11,53 @@
 #include "Character/ALSBaseCharacter.h"
 #include "Components/ActorComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Library/ALSBakedCurve.h"
 
 #include "ALSMantleComponent.generated.h"
 
 // forward declarations
 class UALSDebugComponent;
 
+/**
+ * Mantle start replicated to simulated proxies. The mantle target is sent relative to the ledge component
+ * with a quantized location and compressed rotation.
+ */
+USTRUCT()
+struct FALSReplicatedMantle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UPrimitiveComponent* Component = nullptr;
+
+	/** Mantle target relative to the ledge component */
+	UPROPERTY()
+	FVector LocalLocation = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator LocalRotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	float MantleHeight = 0.0f;
+
+	UPROPERTY()
+	EALSMantleType MantleType = EALSMantleType::HighMantle;
+
+	/** Incremented for every mantle so that identical mantles are replicated too */
+	UPROPERTY()
+	uint8 MantleCount = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSReplicatedMantle> : public TStructOpsTypeTraitsBase2<FALSReplicatedMantle>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
 
 UCLASS(Blueprintable, BlueprintType)
 class ALSV4_CPP_API UALSMantleComponent : public UActorComponent
@@ -57,19 +98,45 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 	/** Mantling*/
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Mantle System")
 	void Server_MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
 	                        EALSMantleType MantleType);
 
-	UFUNCTION(BlueprintCallable, NetMulticast, Reliable, Category = "ALS|Mantle System")
-	void Multicast_MantleStart(float MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
-	                           EALSMantleType MantleType);
+	/** Server rejected the mantle request of the owning client */
+	UFUNCTION(Client, Reliable, Category = "ALS|Mantle System")
+	void Client_RejectMantle();
 
-protected:
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Mantle System")
-	UTimelineComponent* MantleTimeline = nullptr;
+	UFUNCTION(Category = "ALS|Mantle System")
+	void OnRep_ReplicatedMantle();
+
+	/** Check a mantle request of a remote client, correcting its height and type to what the server sees */
+	bool ValidateMantleRequest(float& MantleHeight, const FALSComponentAndTransform& MantleLedgeWS,
+	                           EALSMantleType& MantleType);
+
+	/** Find the ledge in front of the character with the forward and downward traces */
+	bool TraceLedge(const FALSMantleTraceSettings& TraceSettings, const FVector& CapsuleBaseLocation,
+	                const FVector& TraceDirection, EDrawDebugTrace::Type DebugType, FVector& OutLedgeLocation,
+	                FVector& OutWallNormal, UPrimitiveComponent*& OutComponent);
+
+	/** Find the ledge in front of the character in the precomputed ledge indices */
+	bool FindIndexedLedge(const FALSMantleTraceSettings& TraceSettings, const FVector& CapsuleBaseLocation,
+	                      const FVector& TraceDirection, FVector& OutLedgeLocation, FVector& OutWallNormal,
+	                      UPrimitiveComponent*& OutComponent) const;
+
+	bool CanUseLedgeIndex(const FALSMantleTraceSettings& TraceSettings, const FVector& CapsuleBaseLocation) const;
+
+	FBox GetLedgeQueryBox(const FALSMantleTraceSettings& TraceSettings, const FVector& CapsuleBaseLocation) const;
 
+	/** Advance the mantle playback and update the character's transform */
+	void UpdateMantlePlayback(float DeltaTime);
+
+	/** Cheap pre-filter of the falling mantle check, whether any ledge could be reached within the prediction window */
+	bool CanReachLedge(const FALSMantleTraceSettings& TraceSettings) const;
+
+protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	FALSMantleTraceSettings GroundedTraceSettings;
 
@@ -79,6 +146,18 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	FALSMantleTraceSettings FallingTraceSettings;
 
+	/** Minimum time between two falling mantle checks, 0 checks every frame */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System", meta = (ClampMin = 0))
+	float FallingCheckInterval = 0.05f;
+
+	/**
+	 * Falling mantle checks are skipped for this long when no geometry can be reached within it,
+	 * 0 disables the pre-filter
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System", meta = (ClampMin = 0))
+	float FallingCheckPredictionTime = 0.15f;
+
+	/** Blend in curve of the mantle playback */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	UCurveFloat* MantleTimelineCurve;
 
@@ -90,6 +169,13 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	TEnumAsByte<ECollisionChannel> WalkableSurfaceDetectionChannel = ECC_Visibility;
 
+	/**
+	 * Use the ledge indices placed in the level instead of the live traces where they are available. No ledge in the
+	 * index means no mantle, rebuild the indices whenever the static geometry changes.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
+	bool bUseLedgeIndex = true;
+
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
 	FALSMantleParams MantleParams;
 
@@ -105,13 +191,48 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
 	FTransform MantleAnimatedStartOffset = FTransform::Identity;
 
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
+	bool bMantling = false;
+
+	/** Last mantle started on the server, replicated to simulated proxies */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedMantle)
+	FALSReplicatedMantle ReplicatedMantle;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
+	float MantlePlaybackPosition = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Mantle System")
+	float MantlePlaybackLength = 0.0f;
+
 	/** If a dynamic object has a velocity bigger than this value, do not start mantle */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
 	float AcceptableVelocityWhileMantling = 10.0f;
 
+	/** Distance and height tolerance of the server when validating the mantle requests of clients */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
+	float MantleRequestTolerance = 50.0f;
+
+	/** Minimum time between two accepted mantle requests of a client */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Mantle System")
+	float MinMantleRequestInterval = 0.2f;
+
 private:
 	UPROPERTY()
 	AALSBaseCharacter* OwnerCharacter;
 
 	UALSDebugComponent* DebugComponent = nullptr;
+
+	float FallingCheckCooldown = 0.0f;
+
+	float LastMantleRequestTime = -BIG_NUMBER;
+
+	TSharedPtr<const FALSBakedCurve> PositionCorrectionCurveSamples;
+
+	TSharedPtr<const FALSBakedCurve> BlendInCurveSamples;
+
+	FRotator MantleActualStartRotation = FRotator::ZeroRotator;
+
+	FQuat MantleActualStartQuat = FQuat::Identity;
+
+	FQuat MantleAnimatedStartQuat = FQuat::Identity;
 };
@@ -0,0 +1,133 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+#include "ALSMantleLedgeIndex.generated.h"
+
+// forward declarations
+class UPrimitiveComponent;
+
+/** Mantleable ledge found on static or stationary geometry */
+USTRUCT(BlueprintType)
+struct FALSMantleLedge
+{
+	GENERATED_BODY()
+
+	/** Walkable point on top of the ledge, same as the downward trace location of a mantle check */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Mantle System")
+	FVector Location = FVector::ZeroVector;
+
+	/** Horizontal normal of the wall below the ledge */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Mantle System")
+	FVector WallNormal = FVector::ForwardVector;
+
+	/** Soft reference, the component may be in another level than the index and not be loaded */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Mantle System")
+	TSoftObjectPtr<UPrimitiveComponent> Component;
+};
+
+/** Range of ledges stored in one spatial hash cell */
+USTRUCT()
+struct FALSMantleLedgeCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 FirstLedge = 0;
+
+	UPROPERTY()
+	int32 NumLedges = 0;
+};
+
+/**
+ * Precomputed mantle ledges of the static geometry, stored in a spatial hash. The index covers the bounds of the
+ * static geometry in this actor's level, and scans the geometry of every loaded level within those bounds. Place one
+ * per level and use Build Ledge Index whenever the static geometry changes. Mantle components query the index instead
+ * of tracing for ledges and trust its misses, they keep using the live traces outside of its bounds and near movable
+ * objects.
+ */
+UCLASS()
+class ALSV4_CPP_API AALSMantleLedgeIndex : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AALSMantleLedgeIndex();
+
+	/** Scan the static geometry within this level's bounds for mantleable ledges, same rules as the mantle check */
+	UFUNCTION(CallInEditor, Category = "ALS|Mantle Ledge Index")
+	void BuildLedgeIndex();
+
+	/** Whether the location is inside the area scanned by the last build */
+	bool IsCovered(const FVector& Location) const { return Bounds.IsValid && Bounds.IsInsideOrOn(Location); }
+
+	void GetLedgesInBox(const FBox& Box, TArray<const FALSMantleLedge*>& OutLedges) const;
+
+	int32 GetNumLedges() const { return Ledges.Num(); }
+
+protected:
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Whether the component is static geometry the index is built from */
+	bool IsIndexedComponent(const UPrimitiveComponent* Component) const;
+
+	int64 GetCellKey(const FIntVector& Cell) const;
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	/** Ledges are found with these settings, use the loosest settings of the mantle components */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index")
+	FALSMantleTraceSettings TraceSettings;
+
+	/** Capsule used to check if there is room to stand on a ledge, characters check again with their own capsule */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index")
+	float ReferenceCapsuleRadius = 30.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index")
+	float ReferenceCapsuleHalfHeight = 90.0f;
+
+	/** Distance between the sampled points on top of the static geometry */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index", meta = (ClampMin = 5))
+	float SampleSpacing = 25.0f;
+
+	/** Headings probed for an edge around every sampled point, starting at the component's forward axis */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index", meta = (ClampMin = 4))
+	int32 NumEdgeDirections = 16;
+
+	/** Size of the spatial hash cells */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index", meta = (ClampMin = 50))
+	float CellSize = 200.0f;
+
+	/** Minimum normal Z of a walkable surface */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index")
+	float WalkableFloorZ = 0.71f;
+
+	/** Profile to use to detect objects we allow mantling */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index")
+	FName MantleObjectDetectionProfile = FName(TEXT("IgnoreOnlyPawn"));
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Mantle Ledge Index")
+	TEnumAsByte<ECollisionChannel> WalkableSurfaceDetectionChannel = ECC_Visibility;
+
+	UPROPERTY(VisibleAnywhere, Category = "ALS|Mantle Ledge Index")
+	FBox Bounds = FBox(ForceInit);
+
+	/** Ledges sorted by cell */
+	UPROPERTY()
+	TArray<FALSMantleLedge> Ledges;
+
+	UPROPERTY()
+	TMap<int64, FALSMantleLedgeCell> Cells;
+};
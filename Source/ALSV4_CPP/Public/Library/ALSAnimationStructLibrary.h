@@ -445,6 +445,45 @@ struct FALSAnimRotateInPlace
 	float MaxPlayRate = 3.0f;
 };
 
+USTRUCT(BlueprintType)
+struct FALSAnimLODTier
+{
+	GENERATED_BODY()
+
+	/** Tier is used once the LOD metric reaches this value (distance in cm, mesh LOD index or URO update rate) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Anim LOD")
+	float MinMetricValue = 0.0f;
+
+	/** Foot locking, foot offset traces and pelvis offset */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Anim LOD")
+	bool bUpdateFootIK = true;
+
+	/** Layer blending curve reads */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Anim LOD")
+	bool bUpdateLayerValues = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Anim LOD")
+	bool bUpdateLean = true;
+
+	/** In air land prediction sweep */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Anim LOD")
+	bool bUpdateLandPrediction = true;
+
+	/** Turn in place and rotate in place checks */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Anim LOD")
+	bool bUpdateTurnInPlace = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Anim LOD")
+	bool bUpdateDynamicTransitions = true;
+
+	/**
+	 * Foot IK and layer values are only updated every N frames on this tier. The skipped frame time is accumulated
+	 * and passed to the next update, so interpolations keep their speed.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Anim LOD", Meta = (ClampMin = 1))
+	int32 ReducedRateInterval = 1;
+};
+
 USTRUCT(BlueprintType)
 struct FALSAnimConfiguration
 {
@@ -492,4 +531,8 @@ struct FALSAnimConfiguration
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Main Configuration")
 	float IK_TraceDistanceBelowFoot = 45.0f;
+
+	/** Issue foot IK and land prediction traces asynchronously and use last frame's results */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Main Configuration")
+	bool bUseAsyncGroundTraces = false;
 };
@@ -0,0 +1,55 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// forward declarations
+class UCurveBase;
+class UCurveFloat;
+class UCurveVector;
+
+/**
+ * Curve asset baked into uniformly spaced samples, evaluated with a single linear interpolation instead of a
+ * key search per channel. Float curves are stored in the X channel.
+ */
+struct ALSV4_CPP_API FALSBakedCurve
+{
+	void Bake(const UCurveFloat* Curve, float SampleInterval);
+
+	void Bake(const UCurveVector* Curve, float SampleInterval);
+
+	bool IsBaked() const { return Samples.Num() > 0; }
+
+	float GetMinTime() const { return MinTime; }
+
+	float GetMaxTime() const { return MaxTime; }
+
+	FVector EvaluateVector(float Time) const;
+
+	float EvaluateFloat(float Time) const { return EvaluateVector(Time).X; }
+
+	/**
+	 * Baked copy of the curve asset shared by all users of the same sample interval, baked on first use. Game thread
+	 * only.
+	 * In the editor, the copy is baked again in place whenever the asset is edited.
+	 */
+	static TSharedPtr<const FALSBakedCurve> FindOrBake(const UCurveBase* Curve, float SampleInterval);
+
+private:
+	void SetTimeRange(float InMinTime, float InMaxTime, float SampleInterval);
+
+	float MinTime = 0.0f;
+
+	float MaxTime = 0.0f;
+
+	float SamplesPerSecond = 0.0f;
+
+	TArray<FVector> Samples;
+};
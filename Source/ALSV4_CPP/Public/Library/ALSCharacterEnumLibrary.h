@@ -26,7 +26,8 @@ static FORCEINLINE FString GetEnumerationToString(const Enumeration InValue)
 }
 
 /**
- * Character gait state. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums
+ * Character gait state. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums, and the bit
+ * count and last value checked in FALSReplicatedLocomotion::NetSerialize
  */
 UENUM(BlueprintType)
 enum class EALSGait : uint8
@@ -63,7 +64,8 @@ enum class EALSMovementState : uint8
 };
 
 /**
- * Character overlay state. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums
+ * Character overlay state. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums, and the bit
+ * count and last value checked in FALSReplicatedLocomotion::NetSerialize
  */
 UENUM(BlueprintType)
 enum class EALSOverlayState : uint8
@@ -84,7 +86,8 @@ enum class EALSOverlayState : uint8
 };
 
 /**
- * Character rotation mode. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums
+ * Character rotation mode. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums, and the bit
+ * count and last value checked in FALSReplicatedLocomotion::NetSerialize
  */
 UENUM(BlueprintType)
 enum class EALSRotationMode : uint8
@@ -95,7 +98,8 @@ enum class EALSRotationMode : uint8
 };
 
 /**
- * Character stance. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums
+ * Character stance. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums, and the bit
+ * count and last value checked in FALSReplicatedLocomotion::NetSerialize
  */
 UENUM(BlueprintType)
 enum class EALSStance : uint8
@@ -105,7 +109,8 @@ enum class EALSStance : uint8
 };
 
 /**
- * Character view mode. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums
+ * Character view mode. Note: Also edit related struct in ALSStructEnumLibrary if you add new enums, and the bit
+ * count and last value checked in FALSReplicatedLocomotion::NetSerialize
  */
 UENUM(BlueprintType)
 enum class EALSViewMode : uint8
@@ -122,6 +127,14 @@ enum class EALSAnimFeatureExample : uint8
 	SprintImpulse
 };
 
+UENUM(BlueprintType)
+enum class EALSAnimLODMetric : uint8
+{
+	Distance,
+	MeshLOD,
+	UpdateRate
+};
+
 UENUM(BlueprintType)
 enum class EALSFootstepType : uint8
 {
@@ -131,6 +144,13 @@ enum class EALSFootstepType : uint8
 	Land
 };
 
+UENUM(BlueprintType)
+enum class EALSFootstepTraceMode : uint8
+{
+	Synchronous,
+	Asynchronous
+};
+
 UENUM(BlueprintType)
 enum class EALSGroundedEntryState : uint8
 {
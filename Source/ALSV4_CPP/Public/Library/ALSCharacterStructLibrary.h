@@ -91,6 +91,59 @@ struct FALSCameraStateSettings
 	FALSCameraGaitSettings Aiming;
 };
 
+/** Camera behavior parameters, equivalent to the curves of the camera behavior anim graph */
+USTRUCT(BlueprintType)
+struct FALSCameraBehaviorParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera")
+	float RotationLagSpeed = 20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera")
+	FVector PivotLagSpeed = FVector(15.0f, 15.0f, 10.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera")
+	FVector PivotOffset = FVector::ZeroVector;
+
+	/** Camera offset for the right shoulder, mirrored for the left one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera")
+	FVector CameraOffset = FVector(-250.0f, 50.0f, 0.0f);
+};
+
+USTRUCT(BlueprintType)
+struct FALSCameraBehaviorGaitParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Camera")
+	FALSCameraBehaviorParams Walking;
+
+	UPROPERTY(EditAnywhere, Category = "Camera")
+	FALSCameraBehaviorParams Running;
+
+	UPROPERTY(EditAnywhere, Category = "Camera")
+	FALSCameraBehaviorParams Sprinting;
+
+	UPROPERTY(EditAnywhere, Category = "Camera")
+	FALSCameraBehaviorParams Crouching;
+};
+
+USTRUCT(BlueprintType)
+struct FALSCameraBehaviorStateParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Camera")
+	FALSCameraBehaviorGaitParams VelocityDirection;
+
+	UPROPERTY(EditAnywhere, Category = "Camera")
+	FALSCameraBehaviorGaitParams LookingDirection;
+
+	UPROPERTY(EditAnywhere, Category = "Camera")
+	FALSCameraBehaviorGaitParams Aiming;
+};
+
 USTRUCT(BlueprintType)
 struct FALSMantleAsset
 {
@@ -312,3 +365,21 @@ struct FALSHitFX : public FTableRowBase
 	UPROPERTY(EditAnywhere, Category = "Niagara")
 	FRotator NiagaraRotationOffset;
 };
+
+USTRUCT(BlueprintType)
+struct FALSLocomotionReplicationTier
+{
+	GENERATED_BODY()
+
+	/** Tier is used for viewers at least this far away */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Replication")
+	float MinDistance = 0.0f;
+
+	/** Minimum time between two acceleration and control rotation updates sent to a viewer on this tier */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Replication")
+	float UpdateInterval = 0.0f;
+
+	/** Never send acceleration and control rotation to viewers on this tier */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Replication")
+	bool bDropLocomotionData = false;
+};
@@ -31,6 +31,9 @@ public:
 
 	static TPair<float, float> FixDiagonalGamepadValues(float X, float Y);
 
+	/** Distance to the closest player view. Falls back to player view points when nothing was rendered (e.g. servers) */
+	static float GetClosestViewDistance(const UWorld* World, const FVector& Location);
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
 	static FTransform TransfromSub(const FTransform& T1, const FTransform& T2)
 	{
@@ -58,6 +61,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
 	static bool AngleInRange(float Angle, float MinAngle, float MaxAngle, float Buffer, bool IncreaseBuffer);
 
+	/** FMath::FInterpTo on four channels at once */
+	static FORCEINLINE VectorRegister VectorInterpTo(const VectorRegister& Current, const VectorRegister& Target,
+	                                                 float DeltaTime, float InterpSpeed)
+	{
+		// If no interp speed, jump to target value
+		if (InterpSpeed <= 0.0f)
+		{
+			return Target;
+		}
+
+		// Channels already close to the target snap to it, the others move by the clamped interp amount
+		const VectorRegister Dist = VectorSubtract(Target, Current);
+		const VectorRegister SnapMask = VectorCompareGT(VectorSetFloat1(SMALL_NUMBER), VectorMultiply(Dist, Dist));
+		const VectorRegister Alpha = VectorSetFloat1(FMath::Clamp<float>(DeltaTime * InterpSpeed, 0.0f, 1.0f));
+		return VectorSelect(SnapMask, Target, VectorMultiplyAdd(Dist, Alpha, Current));
+	}
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Math Utils")
 	static EALSMovementDirection CalculateQuadrant(EALSMovementDirection Current, float FRThreshold, float FLThreshold,
 	                                               float BRThreshold,
@@ -0,0 +1,126 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+
+#include "ALSReplicationGraph.generated.h"
+
+// forward declarations
+class AALSBaseCharacter;
+
+/**
+ * Connection node applying the locomotion replication tiers of the ALS characters to the connection: characters on a
+ * reduced rate tier replicate to it at most once per tier interval. Gathers no actors itself, only the characters the
+ * global nodes gathered for the connection are evaluated, so it has to be added after them.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSReplicationGraphNode_LocomotionTiers : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override
+	{
+	}
+
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override
+	{
+		return false;
+	}
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	float ServerMaxTickRate = 30.0f;
+
+	/** Tiers are evaluated again every this many replication frames */
+	uint32 UpdatePeriodFrame = 1;
+};
+
+/**
+ * Replication graph for worlds with many ALS characters. Characters and other movable actors are bucketed into a
+ * spatial grid, so connections only consider the cells around their viewers. Each connection always gets its own
+ * pawn, controller and owner only actors, and actors owned by an ALS character replicate together with it. The
+ * locomotion replication tiers of the characters lower how often they replicate to far connections.
+ * Enable with ReplicationDriverClassName="/Script/ALSV4_CPP.ALSReplicationGraph" in the net driver settings.
+ */
+UCLASS(Transient, Config = Engine)
+class ALSV4_CPP_API UALSReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+
+	virtual void InitGlobalGraphNodes() override;
+
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo,
+	                                         FGlobalActorReplicationInfo& GlobalInfo) override;
+
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	/** Size of the spatial grid cells */
+	UPROPERTY(Config)
+	float GridCellSize = 10000.0f;
+
+	/** Offset of the grid origin, should be below the smallest world coordinates so that cells start at zero */
+	UPROPERTY(Config)
+	FVector2D SpatialBias = FVector2D(-200000.0f, -200000.0f);
+
+	/** ALS characters further than this from every viewer of a connection are not replicated to it */
+	UPROPERTY(Config)
+	float CharacterCullDistance = 15000.0f;
+
+	/** Priority scale of the distance to the viewer, further characters replicate less often when saturated */
+	UPROPERTY(Config)
+	float CharacterDistancePriorityScale = 1.0f;
+
+	/** Replication frames between two evaluations of the locomotion replication tiers of a connection */
+	UPROPERTY(Config)
+	int32 LocomotionTierUpdatePeriodFrame = 10;
+
+private:
+	/** ALS character owning the actor, directly or through its owner chain */
+	static AALSBaseCharacter* GetOwningCharacter(const AActor* Actor);
+
+	/** Connection owning the actor, the parent connection for split screen players */
+	static UNetConnection* GetOwningConnection(const AActor* Actor);
+
+	/** Replication settings of an ALS character class, from its defaults */
+	void InitCharacterClassInfo(UClass* Class);
+
+	/** The graph isn't told about owner changes, route the actors whose owner changed since they were added again */
+	void RouteChangedOwners();
+
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode = nullptr;
+
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode = nullptr;
+
+	UPROPERTY()
+	TMap<UNetConnection*, UReplicationGraphNode_AlwaysRelevant_ForConnection*> AlwaysRelevantForConnectionNodes;
+
+	/** ALS character classes with their own replication settings */
+	UPROPERTY()
+	TSet<UClass*> CharacterClasses;
+
+	/** Actors replicating with an ALS character, with the character they were added under */
+	TMap<AActor*, TWeakObjectPtr<AALSBaseCharacter>> DependentActorOwners;
+
+	/** Owner only actors, with the connection whose node they were added to. Null while they have no connection */
+	TMap<AActor*, UNetConnection*> OwnerOnlyActorConnections;
+};
@@ -0,0 +1,86 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Character/Animation/ALSCharacterAnimInstance.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSAnimationSubsystem.generated.h"
+
+// forward declarations
+class UALSAnimationSubsystem;
+class USkeletalMeshComponent;
+
+/** Tick of the animation subsystem, after the batched characters and before their skeletal meshes */
+USTRUCT()
+struct FALSAnimationTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UALSAnimationSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSAnimationTickFunction> : public TStructOpsTypeTraitsBase2<FALSAnimationTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * World subsystem computing the movement values (velocity blend, lean, stride blend, play rates and yaw offsets) of
+ * all registered anim instances in one batch. The inputs and values are gathered into contiguous arrays on the game
+ * thread, computed in parallel and written back before the skeletal meshes update their animation. Only meshes
+ * updating every frame are batched, the others compute their values in their own update.
+ */
+UCLASS(Config = Game)
+class ALSV4_CPP_API UALSAnimationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterAnimInstance(UALSCharacterAnimInstance* AnimInstance);
+
+	void UnregisterAnimInstance(UALSCharacterAnimInstance* AnimInstance);
+
+	void UpdateMovementValues(float DeltaTime);
+
+	/** Batches smaller than this are computed on the game thread */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "ALS|Animation")
+	int32 MinParallelBatchSize = 32;
+
+private:
+	void RemoveAnimInstanceAt(int32 Index);
+
+	/** Whether the mesh updates its animation every frame, with the world's delta time */
+	static bool IsUpdatingEveryFrame(const USkeletalMeshComponent* Mesh);
+
+	FALSAnimationTickFunction TickFunction;
+
+	TArray<TWeakObjectPtr<UALSCharacterAnimInstance>> AnimInstances;
+
+	/** Instances with movement values to compute this frame, with their inputs and values at the same index */
+
+	TArray<UALSCharacterAnimInstance*> BatchedInstances;
+
+	TArray<FALSAnimMovementInput> Inputs;
+
+	TArray<FALSAnimMovementValues> Values;
+};
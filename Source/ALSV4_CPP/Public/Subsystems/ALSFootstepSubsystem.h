@@ -0,0 +1,148 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSFootstepSubsystem.generated.h"
+
+// forward declarations
+class UDataTable;
+class UALSAnimNotifyFootstep;
+class UAudioComponent;
+class UDecalComponent;
+class UMaterialInterface;
+class USceneComponent;
+class USkeletalMeshComponent;
+class USoundBase;
+
+/** Footstep waiting for its asynchronous surface trace */
+struct FALSPendingFootstep
+{
+	TWeakObjectPtr<const UALSAnimNotifyFootstep> Notify;
+
+	TWeakObjectPtr<USkeletalMeshComponent> MeshComp;
+
+	FRotator FootRotation = FRotator::ZeroRotator;
+
+	float MaskCurveValue = 0.0f;
+};
+
+/**
+ * World subsystem managing footstep FX shared by all characters: asset streaming, distance and budget culling,
+ * audio component pooling and a cap on live decals. Settings are read from the [/Script/ALSV4_CPP.ALSFootstepSubsystem]
+ * section of the game config.
+ */
+UCLASS(Config = Game)
+class ALSV4_CPP_API UALSFootstepSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Start streaming every sound, decal and niagara asset of a hit FX table. Returns false if already requested */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Footstep System")
+	bool PreloadHitFX(UDataTable* HitDataTable);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Footstep System")
+	bool IsHitFXPreloadRequested(UDataTable* HitDataTable) const { return HitFXPreloadHandles.Contains(HitDataTable); }
+
+	/** Queue an async surface trace for a footstep. All traces of a frame run as one batch, FX spawn on the next frame */
+	void QueueFootstepTrace(const UALSAnimNotifyFootstep* Notify, USkeletalMeshComponent* MeshComp,
+	                        const FVector& TraceStart, const FVector& TraceEnd, ECollisionChannel TraceChannel,
+	                        const FRotator& FootRotation, float MaskCurveValue);
+
+	/**
+	 * True if a local player views or listens from close enough to notice the FX of a footstep at this location.
+	 * Always false without local players, so don't use it to cull footsteps on dedicated servers.
+	 */
+	bool IsInFootstepFXRange(const FVector& Location);
+
+	/** Consume one footstep of this frame's FX budget. Returns false if the budget is exhausted */
+	bool ConsumeFootstepFXBudget();
+
+	/** Play a sound on a pooled audio component. Returns nullptr if all pooled components are busy */
+	UAudioComponent* PlaySoundAtLocation(USoundBase* Sound, const FVector& Location, const FRotator& Rotation,
+	                                     float VolumeMultiplier, float PitchMultiplier);
+
+	/** Play a sound on a pooled audio component, attached the same way UGameplayStatics::SpawnSoundAttached does */
+	UAudioComponent* PlaySoundAttached(USoundBase* Sound, USceneComponent* AttachToComponent, FName AttachPointName,
+	                                   const FVector& Location, const FRotator& Rotation,
+	                                   EAttachLocation::Type LocationType, float VolumeMultiplier,
+	                                   float PitchMultiplier);
+
+	/** Spawn a decal, reusing the least recently spawned one once MaxLiveDecals is reached */
+	UDecalComponent* SpawnDecalAtLocation(UMaterialInterface* DecalMaterial, const FVector& DecalSize,
+	                                      const FVector& Location, const FRotator& Rotation, float LifeSpan);
+
+	/** Spawn an attached decal, destroying the least recently spawned one once MaxLiveDecals is reached */
+	UDecalComponent* SpawnDecalAttached(UMaterialInterface* DecalMaterial, const FVector& DecalSize,
+	                                    USceneComponent* AttachToComponent, const FVector& Location,
+	                                    const FRotator& Rotation, EAttachLocation::Type LocationType, float LifeSpan);
+
+	/** Footsteps further away from every local player view are not spawned */
+	UPROPERTY(Config, BlueprintReadWrite, Category = "ALS|Footstep System")
+	float MaxFootstepFXDistance = 3000.0f;
+
+	/** Maximum amount of footsteps spawning FX in a single frame */
+	UPROPERTY(Config, BlueprintReadWrite, Category = "ALS|Footstep System")
+	int32 MaxFootstepFXPerFrame = 16;
+
+	/** Maximum amount of audio components kept for footstep sounds */
+	UPROPERTY(Config, BlueprintReadWrite, Category = "ALS|Footstep System")
+	int32 MaxPooledAudioComponents = 32;
+
+	/** Maximum amount of footstep decals alive at the same time */
+	UPROPERTY(Config, BlueprintReadWrite, Category = "ALS|Footstep System")
+	int32 MaxLiveDecals = 64;
+
+private:
+	void UpdateViewLocations();
+
+	UAudioComponent* AcquireAudioComponent();
+
+	TWeakObjectPtr<UDecalComponent>& AcquireDecalSlot();
+
+	void OnFootstepTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	FStreamableManager StreamableManager;
+
+	/** Handles keep the streamed assets alive for the lifetime of the world */
+	TMap<TWeakObjectPtr<const UDataTable>, TSharedPtr<FStreamableHandle>> HitFXPreloadHandles;
+
+	FTraceDelegate FootstepTraceDelegate;
+
+	/** Footsteps waiting for their trace results, keyed by the trace user data */
+	TMap<uint32, FALSPendingFootstep> PendingFootsteps;
+
+	uint32 NextFootstepTraceId = 0;
+
+	/** Local player view locations, gathered once per frame */
+	TArray<FVector> ViewLocations;
+
+	uint64 ViewLocationsFrame = 0;
+
+	uint64 FootstepFXBudgetFrame = 0;
+
+	int32 FootstepFXThisFrame = 0;
+
+	UPROPERTY(Transient)
+	TArray<UAudioComponent*> AudioComponentPool;
+
+	/** Ring of live decals, the next slot to be used is the least recently spawned one */
+	TArray<TWeakObjectPtr<UDecalComponent>> DecalRing;
+
+	int32 DecalRingHead = 0;
+};
@@ -0,0 +1,111 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSLocomotionSubsystem.generated.h"
+
+// forward declarations
+class AALSBaseCharacter;
+class UALSLocomotionSubsystem;
+
+/** Pre physics tick of the locomotion subsystem, a prerequisite of every batched character's tick */
+USTRUCT()
+struct FALSLocomotionTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UALSLocomotionSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FALSLocomotionTickFunction> : public TStructOpsTypeTraitsBase2<FALSLocomotionTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * World subsystem updating the essential values (acceleration, speed, movement input amount, aim yaw rate and
+ * aiming rotation) of all registered characters in one batch. The values are kept as structure of arrays, gathered
+ * from and written back to the characters on the game thread and computed in parallel in between.
+ */
+UCLASS(Config = Game)
+class ALSV4_CPP_API UALSLocomotionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterCharacter(AALSBaseCharacter* Character);
+
+	void UnregisterCharacter(AALSBaseCharacter* Character);
+
+	void UpdateEssentialValues(float DeltaTime);
+
+	/** Batches smaller than this are computed on the game thread */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "ALS|Movement System")
+	int32 MinParallelBatchSize = 64;
+
+private:
+	void RemoveCharacterAt(int32 Index);
+
+	FALSLocomotionTickFunction TickFunction;
+
+	TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+
+	/** Inputs, gathered every frame */
+
+	TArray<FVector> Velocities;
+
+	TArray<FVector> CurrentAccelerations;
+
+	TArray<FRotator> ControlRotations;
+
+	TArray<float> MaxAccelerations;
+
+	/** Delta time of the character this frame, zero if it doesn't tick this frame */
+	TArray<float> DeltaTimes;
+
+	/** State kept between frames */
+
+	/** Dilated time since the last update of the character, characters with a tick interval accumulate it */
+	TArray<float> AccumulatedDeltaTimes;
+
+	TArray<FVector> PreviousVelocities;
+
+	TArray<float> PreviousAimYaws;
+
+	TArray<FRotator> AimingRotations;
+
+	TArray<FRotator> LastVelocityRotations;
+
+	TArray<FRotator> LastMovementInputRotations;
+
+	/** Outputs */
+
+	TArray<FVector> Accelerations;
+
+	TArray<float> Speeds;
+
+	TArray<float> MovementInputAmounts;
+
+	TArray<float> AimYawRates;
+};
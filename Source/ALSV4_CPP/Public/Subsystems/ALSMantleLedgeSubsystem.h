@@ -0,0 +1,42 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSMantleLedgeSubsystem.generated.h"
+
+// forward declarations
+class AALSMantleLedgeIndex;
+struct FALSMantleLedge;
+
+/**
+ * World subsystem keeping track of the mantle ledge indices of all loaded levels
+ */
+UCLASS()
+class ALSV4_CPP_API UALSMantleLedgeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterLedgeIndex(AALSMantleLedgeIndex* LedgeIndex);
+
+	void UnregisterLedgeIndex(AALSMantleLedgeIndex* LedgeIndex);
+
+	bool HasLedgeIndices() const { return LedgeIndices.Num() > 0; }
+
+	/** Whether the location is covered by a ledge index, otherwise ledges have to be found with the live traces */
+	bool IsCovered(const FVector& Location) const;
+
+	void GetLedgesInBox(const FBox& Box, TArray<const FALSMantleLedge*>& OutLedges) const;
+
+private:
+	TArray<TWeakObjectPtr<AALSMantleLedgeIndex>> LedgeIndices;
+};
@@ -0,0 +1,126 @@
+// Project:         Advanced Locomotion System V4 on C++
+// Copyright:       Copyright (C) 2021 Doğa Can Yanıkoğlu
+// License:         MIT License (http://www.opensource.org/licenses/mit-license.php)
+// Source Code:     https://github.com/dyanikoglu/ALSV4_CPP
+// Original Author: Doğa Can Yanıkoğlu
+// Contributors:    
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+
+#include "ALSSignificanceSubsystem.generated.h"
+
+// forward declarations
+class AALSBaseCharacter;
+
+/**
+ * Tick rates used by characters of a significance level. The first level keeps the intervals the character was set up
+ * with, the other levels never tick faster than those.
+ */
+USTRUCT(BlueprintType)
+struct FALSSignificanceLevel
+{
+	GENERATED_BODY()
+
+	/** Level is used once the closest player view is at least this far away */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance")
+	float MinDistance = 0.0f;
+
+	/** Character tick interval in seconds, 0 ticks every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance")
+	float ActorTickInterval = 0.0f;
+
+	/** Mesh (and so anim instance) tick interval in seconds, 0 ticks every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance")
+	float MeshTickInterval = 0.0f;
+
+	/** Character movement tick interval in seconds, 0 ticks every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance")
+	float MovementTickInterval = 0.0f;
+};
+
+/** Character registered to the significance subsystem */
+struct FALSSignificantCharacter
+{
+	TWeakObjectPtr<AALSBaseCharacter> Character;
+
+	int32 Level = INDEX_NONE;
+
+	/** Tick intervals the character was registered with, restored on the first level and when unregistered */
+
+	float ActorTickInterval = 0.0f;
+
+	float MeshTickInterval = 0.0f;
+
+	float MovementTickInterval = 0.0f;
+};
+
+/**
+ * World subsystem lowering the tick rates of insignificant characters. Significance is evaluated periodically from
+ * the distance to the closest player view, whether the character was rendered recently and whether it is player
+ * controlled. Settings are read from the [/Script/ALSV4_CPP.ALSSignificanceSubsystem] section of the game config.
+ */
+UCLASS(Config = Game)
+class ALSV4_CPP_API UALSSignificanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UALSSignificanceSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/** FTickableGameObject */
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	virtual bool IsTickable() const override;
+
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	virtual TStatId GetStatId() const override;
+
+	/** Significance */
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	void RegisterCharacter(AALSBaseCharacter* Character);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	void UnregisterCharacter(AALSBaseCharacter* Character);
+
+	/** Returns the current significance level index of a registered character, INDEX_NONE if it isn't registered */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	int32 GetSignificanceLevel(const AALSBaseCharacter* Character) const;
+
+	/** Levels sorted by ascending distance. Player controlled characters always use the first level */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance")
+	TArray<FALSSignificanceLevel> SignificanceLevels;
+
+	/** Characters not rendered within this time use at least NotRenderedLevel. Ignored on dedicated servers */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance")
+	float NotRenderedTime = 0.5f;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance")
+	int32 NotRenderedLevel = 1;
+
+	/** Time between two significance evaluations */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance")
+	float UpdateInterval = 0.25f;
+
+private:
+	int32 CalculateSignificanceLevel(const AALSBaseCharacter* Character) const;
+
+	void ApplySignificanceLevel(const FALSSignificantCharacter& Entry) const;
+
+	static void RestoreTickIntervals(const FALSSignificantCharacter& Entry);
+
+	TArray<FALSSignificantCharacter> Characters;
+
+	float TimeSinceLastUpdate = 0.0f;
+};